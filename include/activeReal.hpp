@@ -35,6 +35,7 @@
 #include "expressionTraits.hpp"
 
 #include <iostream>
+#include <utility>
 
 /**
  * @brief Global namespace for CoDiPack - Code Differentiation Package
@@ -87,9 +88,9 @@ namespace codi {
     static const bool storeAsReference = true;
 
     /**
-     * @brief Static definition of the tape.
+     * @brief Static definition of the tape. It is thread local if CODI_ThreadLocalTape is set.
      */
-    static Tape globalTape;
+    static CODI_TAPE_STORAGE Tape globalTape;
 
     /**
      * @brief The tape used for the derivative calculations.
@@ -193,6 +194,20 @@ namespace codi {
       }
     }
 
+    /**
+     * @brief Move constructor. Takes over the gradient data of v without a statement on the tape.
+     *
+     * v is left as a passive value with the same primal value. For index tapes the index is moved,
+     * therefore no use count is changed.
+     *
+     * @param[in,out] v The value to move.
+     */
+    CODI_INLINE ActiveReal(ActiveReal<Tape>&& v) noexcept :
+      primalValue(std::move(v.primalValue)),
+      gradientData(std::move(v.gradientData)) {
+      globalTape.initGradientData(v.primalValue, v.gradientData);
+    }
+
     /**
      * @brief Call the tape to destroy the gradient data.
      */
@@ -431,6 +446,26 @@ namespace codi {
       return *this;
     }
 
+    /**
+     * @brief Move assignment. Takes over the gradient data of the rhs without a statement on the tape.
+     *
+     * The gradient data of this instance is destroyed and the rhs is left as a passive value with the
+     * same primal value.
+     *
+     * @param[in,out] rhs The other value on the rhs.
+     * @return Reference to this.
+     */
+    CODI_INLINE ActiveReal<Tape>& operator=(ActiveReal<Tape>&& rhs) {
+      if(this != &rhs) {
+        globalTape.destroyGradientData(primalValue, gradientData);
+
+        primalValue = std::move(rhs.primalValue);
+        gradientData = std::move(rhs.gradientData);
+        globalTape.initGradientData(rhs.primalValue, rhs.gradientData);
+      }
+      return *this;
+    }
+
     /**
      * @brief The expression is unfolded to *this = *this + rhs
      *
@@ -659,7 +694,7 @@ namespace codi {
 #if CODI_EnableVariableAdjointInterfaceInPrimalTapes
         adjointValues->updateJacobiTangent(indices[offset], seed);
 #else
-        lhsAdjoint += adjointValues[indices[offset]] * seed;
+        addScaled(lhsAdjoint, adjointValues[indices[offset]], seed);
 #endif
       }
 
@@ -699,7 +734,7 @@ namespace codi {
    * @brief The instantiation of the tape for the ActiveReal.
    */
   template<typename Tape>
-  Tape ActiveReal<Tape>::globalTape;
+  CODI_TAPE_STORAGE Tape ActiveReal<Tape>::globalTape;
 
   /**
    * @brief Specialization of the ExpressionTraits for the ActiveReal type.
@@ -59,13 +59,13 @@ namespace codi {
        * @param[in] index  The position for the adjoint.
        * @param[in]   dim  The dimension in the vector.
        */
-      virtual void resetAdjoint(const int index, const size_t dim) = 0;
+      virtual void resetAdjoint(const size_t index, const size_t dim) = 0;
 
       /**
        * @brief Set the adjoint vector at the position to zero.
        * @param[in] index  The position for the adjoint.
        */
-      virtual void resetAdjointVec(const int index) = 0;
+      virtual void resetAdjointVec(const size_t index) = 0;
 
       /**
        * @brief Get the adjoint value at the specified position and dimension.
@@ -78,7 +78,7 @@ namespace codi {
        * @param[in]   dim  The dimension in the vector.
        * @return The adjoint value at the position with the dimension.
        */
-      virtual Real getAdjoint(const int index, const size_t dim) = 0;
+      virtual Real getAdjoint(const size_t index, const size_t dim) = 0;
 
       /**
        * @brief Get the adjoint vector at the specified position.
@@ -94,7 +94,7 @@ namespace codi {
        * @param[in] index  The position for the adjoint
        * @param[out]  vec  The vector for the storage of the data.
        */
-      virtual void getAdjointVec(const int index, Real* vec) = 0;
+      virtual void getAdjointVec(const size_t index, Real* vec) = 0;
 
       /**
        * @brief Update the adjoint value at the specified position and dimension.
@@ -107,7 +107,7 @@ namespace codi {
        * @param[in]     dim  The dimension in the vector.
        * @param[in] adjoint  The update for the adjoint value.
        */
-      virtual void updateAdjoint(const int index, const size_t dim, const Real adjoint) = 0;
+      virtual void updateAdjoint(const size_t index, const size_t dim, const Real adjoint) = 0;
 
       /**
        * @brief Update the adjoint vector at the specified position.
@@ -123,7 +123,7 @@ namespace codi {
        * @param[in]   index  The position for the adjoint
        * @param[in]     vec  The update for the adjoint vector.
        */
-      virtual void updateAdjointVec(const int index, const Real* vec) = 0;
+      virtual void updateAdjointVec(const size_t index, const Real* vec) = 0;
 
       /**
        * @brief The adjoint target for the adjoint of the left hand side of an equation.
@@ -144,7 +144,7 @@ namespace codi {
        *
        * @param[in] index  The index of the adjoint value that is stored and reset to zero.
        */
-      virtual void setLhsAdjoint(const int index) = 0;
+      virtual void setLhsAdjoint(const size_t index) = 0;
 
       /**
        * @brief Updates the target adjoint with the prior specified lhs multiplied with the jacobi.
@@ -154,7 +154,7 @@ namespace codi {
        * @param[in]  index  The index of the adjoint value that receives the update.
        * @param[in] jacobi  The jacobi value that is multiplied with the lhs adjoint.
        */
-      virtual void updateJacobiAdjoint(const int index, Real jacobi) = 0;
+      virtual void updateJacobiAdjoint(const size_t index, Real jacobi) = 0;
 
       /**
        * @brief The tangent target for the tangent of the left hand side of an equation.
@@ -173,7 +173,7 @@ namespace codi {
        *
        * @param[in] index  The index of the tangent value that is set to the current accumulated value.
        */
-      virtual void setLhsTangent(const int index) = 0;
+      virtual void setLhsTangent(const size_t index) = 0;
 
       /**
        * @brief Updates the lhs tangent with the jacobian multiplied with target tangent value.
@@ -183,7 +183,7 @@ namespace codi {
        * @param[in]  index  The index of the tangent value that is used for the update.
        * @param[in] jacobi  The jacobi value that is multiplied with the tangnet value defined by index.
        */
-      virtual void updateJacobiTangent(const int index, Real jacobi) = 0;
+      virtual void updateJacobiTangent(const size_t index, Real jacobi) = 0;
 
       /**
        * @brief Some tapes need to revert the primal values in the primal value vector to the old value
@@ -195,6 +195,6 @@ namespace codi {
        * @param[in]  index  The index of the primal value that needs to be reverted.
        * @param[in] primal  The primal value that is set.
        */
-      virtual void resetPrimal(const int index, Real primal) = 0;
+      virtual void resetPrimal(const size_t index, Real primal) = 0;
   };
 }
@@ -76,7 +76,7 @@ namespace codi {
        * @param[in] index  The position for the adjoint.
        * @param[in]   dim  The dimension in the vector.
        */
-      void resetAdjoint(const int index, const size_t dim) {
+      void resetAdjoint(const size_t index, const size_t dim) {
         CODI_UNUSED(dim);
 
         adjointVector[index] = GradientValue();
@@ -86,7 +86,7 @@ namespace codi {
        * @brief Set the adjoint vector at the position to zero.
        * @param[in] index  The position for the adjoint.
        */
-      void resetAdjointVec(const int index) {
+      void resetAdjointVec(const size_t index) {
         adjointVector[index] = GradientValue();
       }
 
@@ -101,7 +101,7 @@ namespace codi {
        * @param[in]   dim  The dimension in the vector.
        * @return The adjoint value at the position with the dimension.
        */
-      Real getAdjoint(const int index, const size_t dim) {
+      Real getAdjoint(const size_t index, const size_t dim) {
         CODI_UNUSED(dim);
 
         return (Real) adjointVector[index];
@@ -121,7 +121,7 @@ namespace codi {
        * @param[in] index  The position for the adjoint
        * @param[out]  vec  The vector for the storage of the data.
        */
-      void getAdjointVec(const int index, Real* vec) {
+      void getAdjointVec(const size_t index, Real* vec) {
         *vec = (Real)adjointVector[index];
       }
 
@@ -136,7 +136,7 @@ namespace codi {
        * @param[in]     dim  The dimension in the vector.
        * @param[in] adjoint  The update for the adjoint value.
        */
-      virtual void updateAdjoint(const int index, const size_t dim, const Real adjoint) {
+      virtual void updateAdjoint(const size_t index, const size_t dim, const Real adjoint) {
         CODI_UNUSED(dim);
 
         adjointVector[index] += adjoint;
@@ -156,7 +156,7 @@ namespace codi {
        * @param[in] index  The position for the adjoint
        * @param[in]   vec  The update for the adjoint value.
        */
-      virtual void updateAdjointVec(const int index, const Real* vec) {
+      virtual void updateAdjointVec(const size_t index, const Real* vec) {
         adjointVector[index] += *vec;
       }
 
@@ -179,7 +179,7 @@ namespace codi {
        *
        * @param[in] index  The index of the adjoint value that is stored and reset to zero.
        */
-      void setLhsAdjoint(const int index) {
+      void setLhsAdjoint(const size_t index) {
         lhs = adjointVector[index];
       }
 
@@ -191,7 +191,7 @@ namespace codi {
        * @param[in]  index  The index of the adjoint value that receives the update.
        * @param[in] jacobi  The jacobi value that is multiplied with the lhs adjoint.
        */
-      void updateJacobiAdjoint(const int index, Real jacobi) {
+      void updateJacobiAdjoint(const size_t index, Real jacobi) {
         adjointVector[index] += jacobi * lhs;
       }
 
@@ -212,7 +212,7 @@ namespace codi {
        *
        * @param[in] index  The index of the tangent value that is set to the current accumulated value.
        */
-      void setLhsTangent(const int index) {
+      void setLhsTangent(const size_t index) {
         adjointVector[index] = lhs;
         lhs = GradientValue();
       }
@@ -225,7 +225,7 @@ namespace codi {
        * @param[in]  index  The index of the tangent value that is used for the update.
        * @param[in] jacobi  The jacobi value that is multiplied with the tangnet value defined by index.
        */
-      void updateJacobiTangent(const int index, Real jacobi) {
+      void updateJacobiTangent(const size_t index, Real jacobi) {
         lhs +=  jacobi * adjointVector[index];
       }
   };
@@ -267,7 +267,7 @@ namespace codi {
        * @param[in] index  The position for the adjoint.
        * @param[in]   dim  The dimension in the vector.
        */
-      void resetAdjoint(const int index, const size_t dim) {
+      void resetAdjoint(const size_t index, const size_t dim) {
         adjointVector[index][dim] = RealDir();
       }
 
@@ -275,7 +275,7 @@ namespace codi {
        * @brief Set the adjoint vector at the position to zero.
        * @param[in] index  The position for the adjoint.
        */
-      void resetAdjointVec(const int index) {
+      void resetAdjointVec(const size_t index) {
         adjointVector[index] = Direction<RealDir, vecDim>();
       }
 
@@ -290,7 +290,7 @@ namespace codi {
        * @param[in]   dim  The dimension in the vector.
        * @return The adjoint value at the position with the dimension.
        */
-      Real getAdjoint(const int index, const size_t dim) {
+      Real getAdjoint(const size_t index, const size_t dim) {
         return (Real) adjointVector[index][dim];
       }
 
@@ -308,7 +308,7 @@ namespace codi {
        * @param[in] index  The position for the adjoint
        * @param[out]  vec  The vector for the storage of the data.
        */
-      void getAdjointVec(const int index, Real* vec) {
+      void getAdjointVec(const size_t index, Real* vec) {
         for(size_t i = 0; i < vecDim; ++i) {
           vec[i] = (Real)adjointVector[index][i];
         }
@@ -325,7 +325,7 @@ namespace codi {
        * @param[in]     dim  The dimension in the vector.
        * @param[in] adjoint  The update for the adjoint value.
        */
-      virtual void updateAdjoint(const int index, const size_t dim, const Real adjoint) {
+      virtual void updateAdjoint(const size_t index, const size_t dim, const Real adjoint) {
         adjointVector[index][dim] += adjoint;
       }
 
@@ -343,7 +343,7 @@ namespace codi {
        * @param[in] index  The position for the adjoint
        * @param[in]   vec  The update for the adjoint value.
        */
-      virtual void updateAdjointVec(const int index, const Real* vec) {
+      virtual void updateAdjointVec(const size_t index, const Real* vec) {
         for(size_t i = 0; i < vecDim; ++i) {
           adjointVector[index][i] += vec[i];
         }
@@ -368,7 +368,7 @@ namespace codi {
        *
        * @param[in] index  The index of the adjoint value that is stored and reset to zero.
        */
-      void setLhsAdjoint(const int index) {
+      void setLhsAdjoint(const size_t index) {
         lhs = adjointVector[index];
       }
 
@@ -380,7 +380,7 @@ namespace codi {
        * @param[in]  index  The index of the adjoint value that receives the update.
        * @param[in] jacobi  The jacobi value that is multiplied with the lhs adjoint.
        */
-      void updateJacobiAdjoint(const int index, Real jacobi) {
+      void updateJacobiAdjoint(const size_t index, Real jacobi) {
         adjointVector[index] += jacobi * lhs;
       }
 
@@ -401,7 +401,7 @@ namespace codi {
        *
        * @param[in] index  The index of the tangent value that is set to the current accumulated value.
        */
-      void setLhsTangent(const int index) {
+      void setLhsTangent(const size_t index) {
         adjointVector[index] = lhs;
         lhs = Direction<RealDir, vecDim>();
       }
@@ -414,7 +414,7 @@ namespace codi {
        * @param[in]  index  The index of the tangent value that is used for the update.
        * @param[in] jacobi  The jacobi value that is multiplied with the tangnet value defined by index.
        */
-      void updateJacobiTangent(const int index, Real jacobi) {
+      void updateJacobiTangent(const size_t index, Real jacobi) {
         lhs +=  jacobi * adjointVector[index];
       }
   };
@@ -449,7 +449,7 @@ namespace codi {
        * @param[in]  index  The index of the primal value that needs to be reverted.
        * @param[in] primal  The primal value that is set.
        */
-      virtual void resetPrimal(const int index, Real primal) {
+      virtual void resetPrimal(const size_t index, Real primal) {
         CODI_UNUSED(index);
         CODI_UNUSED(primal);
 
@@ -492,7 +492,7 @@ namespace codi {
        * @param[in]  index  The index of the primal value that needs to be reverted.
        * @param[in] primal  The primal value that is set.
        */
-      virtual void resetPrimal(const int index, Real primal) {
+      virtual void resetPrimal(const size_t index, Real primal) {
         primalVector[index] = primal;
       }
   };
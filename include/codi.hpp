@@ -28,18 +28,28 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "activeReal.hpp"
 #include "numericLimits.hpp"
 #include "referenceActiveReal.hpp"
 #include "tapeTypes.hpp"
+#include "tapes/compressedChunk.hpp"
 #include "tapes/forwardEvaluation.hpp"
+#include "tapes/interleavedChunk.hpp"
 #include "tapes/jacobiTape.hpp"
 #include "tapes/jacobiIndexTape.hpp"
 #include "tapes/primalValueTape.hpp"
 #include "tapes/primalValueIndexTape.hpp"
+#include "tapes/swapChunk.hpp"
 #include "tapes/indices/linearIndexHandler.hpp"
 #include "tapes/indices/reuseIndexHandler.hpp"
 #include "tapes/indices/reuseIndexHandlerUseCount.hpp"
+#include "tapes/indices/sortedReuseIndexHandlerUseCount.hpp"
+#include "tools/atomicGradient.hpp"
+#include "tools/blockAdjoint.hpp"
+#include "tools/concurrentEvaluationHelper.hpp"
+#include "tools/tapeJoinHelper.hpp"
 #include "tools/dataStore.hpp"
 #include "tools/derivativeHelper.hpp"
 #include "tools/direction.hpp"
@@ -100,6 +110,18 @@ namespace codi {
   template<size_t dim>
   using RealForwardVec = RealForwardGen<double, Direction<double, dim> >;
 
+  /**
+   * @brief The default reverse type in CoDiPack with a generalized calculation type and a generalized index type.
+   *
+   * See the documentation of #RealReverse.
+   *
+   * @tparam     Real  The underlying calculation type for the AD evaluation. Needs to implement all mathematical functions.
+   * @tparam    Index  The type for the identification of the adjoint values. Needs to be an integral type.
+   * @tparam Gradient  The type of the derivative values for the AD evaluation. Needs to implement an addition and multiplication operation.
+   */
+  template<typename Real, typename Index, typename Gradient = Real>
+  using RealReverseIdxGen = ActiveReal<JacobiTape<JacobiTapeTypes<ReverseTapeTypes<Real, Gradient, LinearIndexHandler<Index> >, ChunkVector > > >;
+
   /**
    * @brief The default reverse type in CoDiPack with a generalized calculation type.
    *
@@ -109,7 +131,7 @@ namespace codi {
    * @tparam Gradient  The type of the derivative values for the AD evaluation. Needs to implement an addition and multiplication operation.
    */
   template<typename Real, typename Gradient = Real>
-  using RealReverseGen = ActiveReal<JacobiTape<JacobiTapeTypes<ReverseTapeTypes<Real, Gradient, LinearIndexHandler<int> >, ChunkVector > > >;
+  using RealReverseGen = RealReverseIdxGen<Real, int, Gradient>;
 
   /**
    * @brief The default reverse type in CoDiPack.
@@ -143,6 +165,21 @@ namespace codi {
    */
   typedef RealReverseGen<double, double > RealReverse;
 
+  /**
+   * @brief The #RealReverse type with 64 bit indices.
+   *
+   * The indices of the #RealReverse type are increased with each statement. The type can be used if more than
+   * 2^31 - 1 statements are recorded.
+   */
+  typedef RealReverseIdxGen<double, int64_t> RealReverse64;
+
+  /**
+   * @brief The #RealReverse type with unsigned 32 bit indices.
+   *
+   * The type can record up to 2^32 - 2 statements without increasing the memory for the indices.
+   */
+  typedef RealReverseIdxGen<double, uint32_t> RealReverseU32;
+
   /**
    * @brief Vector mode of the #RealReverse type.
    *
@@ -204,6 +241,87 @@ namespace codi {
    */
   typedef RealReverseUncheckedGen<double, double> RealReverseUnchecked;
 
+  /**
+   * @brief The reverse type in CoDiPack with a generalized calculation type and a tape that is swapped to disk.
+   *
+   * See the documentation of #RealReverseSwap.
+   *
+   * @tparam     Real  The underlying calculation type for the AD evaluation. Needs to implement all mathematical functions.
+   * @tparam Gradient  The type of the derivative values for the AD evaluation. Needs to implement an addition and multiplication operation.
+   */
+  template<typename Real, typename Gradient = Real>
+  using RealReverseSwapGen = ActiveReal<JacobiTape<JacobiTapeTypes<ReverseTapeTypes<Real, Gradient, LinearIndexHandler<int> >, SwapChunkVector > > >;
+
+  /**
+   * @brief The reverse type in CoDiPack with a tape that is swapped to disk.
+   *
+   * For details on the AD reverse mode see #RealReverse.
+   *
+   * The chunks of the tape are written to a scratch file if the memory of all chunks exceeds the budget of the
+   * SwapChunkStorage. During the reverse evaluation the chunks are read back from the file. The budget can be set with
+   * \code{.cpp}
+   *  codi::SwapChunkStorage::getGlobal().setMemoryBudget(bytes);
+   * \endcode
+   * or with the preprocessor macro CODI_SwapChunkMemory. If CODI_ThreadLocalTape is set, the budget is set for the
+   * storage of the calling thread.
+   */
+  typedef RealReverseSwapGen<double, double> RealReverseSwap;
+
+  /**
+   * @brief The reverse type in CoDiPack with a generalized calculation type and a compressed tape.
+   *
+   * See the documentation of #RealReverseCompressed.
+   *
+   * @tparam     Real  The underlying calculation type for the AD evaluation. Needs to implement all mathematical functions.
+   * @tparam Gradient  The type of the derivative values for the AD evaluation. Needs to implement an addition and multiplication operation.
+   */
+  template<typename Real, typename Gradient = Real>
+  using RealReverseCompressedGen = ActiveReal<JacobiTape<JacobiTapeTypes<ReverseTapeTypes<Real, Gradient, LinearIndexHandler<int> >, CompressedChunkVector > > >;
+
+  /**
+   * @brief The reverse type in CoDiPack with a compressed tape.
+   *
+   * For details on the AD reverse mode see #RealReverse.
+   *
+   * The Jacobi data of the tape is compressed without loss after a chunk has been recorded. The compression
+   * is most effective if the arguments of the statements have close indices and many Jacobies have simple
+   * values like 1.0 or 0.5. The data of a chunk is decompressed during the reverse evaluation.
+   */
+  typedef RealReverseCompressedGen<double, double> RealReverseCompressed;
+
+  /**
+   * @brief The reverse type in CoDiPack with a generalized calculation type and an interleaved tape layout.
+   *
+   * See the documentation of #RealReverseInterleaved.
+   *
+   * @tparam     Real  The underlying calculation type for the AD evaluation. Needs to implement all mathematical functions.
+   * @tparam Gradient  The type of the derivative values for the AD evaluation. Needs to implement an addition and multiplication operation.
+   */
+  template<typename Real, typename Gradient = Real>
+  using RealReverseInterleavedGen = ActiveReal<JacobiTape<JacobiTapeTypes<ReverseTapeTypes<Real, Gradient, LinearIndexHandler<int> >, InterleavedChunkVector > > >;
+
+  /**
+   * @brief The reverse type in CoDiPack with an interleaved tape layout.
+   *
+   * For details on the AD reverse mode see #RealReverse.
+   *
+   * The Jacobies and the indices of the arguments are stored as records in one array instead of two
+   * separate arrays. The reverse evaluation reads therefore one data stream for the arguments.
+   */
+  typedef RealReverseInterleavedGen<double, double> RealReverseInterleaved;
+
+  /**
+   * @brief The reverse type in CoDiPack with a generalized calculation type and an index reuse tape and a generalized index type.
+   *
+   * See the documentation of #RealReverseIndex.
+   *
+   * @tparam     Real  The underlying calculation type for the AD evaluation. Needs to implement all mathematical functions.
+   * @tparam    Index  The type for the identification of the adjoint values. Needs to be an integral type.
+   * @tparam Gradient  The type of the derivative values for the AD evaluation. Needs to implement an addition and multiplication operation.
+   */
+  template<typename Real, typename Index, typename Gradient = Real>
+  using RealReverseIndexIdxGen = ActiveReal<JacobiIndexTape<JacobiIndexTapeTypes<ReverseTapeTypes<Real, Gradient, ReuseIndexHandlerUseCount<Index> >, ChunkVector> > >;
+
   /**
    * @brief The reverse type in CoDiPack with a generalized calculation type and an index reuse tape.
    *
@@ -213,7 +331,7 @@ namespace codi {
    * @tparam Gradient  The type of the derivative values for the AD evaluation. Needs to implement an addition and multiplication operation.
    */
   template<typename Real, typename Gradient = Real>
-  using RealReverseIndexGen = ActiveReal<JacobiIndexTape<JacobiIndexTapeTypes<ReverseTapeTypes<Real, Gradient, ReuseIndexHandlerUseCount<int> >, ChunkVector> > >;
+  using RealReverseIndexGen = RealReverseIndexIdxGen<Real, int, Gradient>;
 
   /**
    * @brief A reverse type like the default reverse type in CoDiPack but with index reuse.
@@ -226,6 +344,18 @@ namespace codi {
    */
   typedef RealReverseIndexGen<double, double> RealReverseIndex;
 
+  /**
+   * @brief The #RealReverseIndex type with 64 bit indices.
+   *
+   * The type can be used if more than 2^31 - 1 variables are alive at the same time.
+   */
+  typedef RealReverseIndexIdxGen<double, int64_t> RealReverseIndex64;
+
+  /**
+   * @brief The #RealReverseIndex type with unsigned 32 bit indices.
+   */
+  typedef RealReverseIndexIdxGen<double, uint32_t> RealReverseIndexU32;
+
   /**
    * @brief Vector mode of the #RealReverseIndex type.
    *
@@ -256,6 +386,38 @@ namespace codi {
    */
   typedef RealReverseIndexUncheckedGen<double, double> RealReverseIndexUnchecked;
 
+  /**
+   * @brief The reverse type in CoDiPack with a generalized calculation type and an index reuse tape that reuses the smallest free index.
+   *
+   * See the documentation of #RealReverseIndexSorted.
+   *
+   * @tparam     Real  The underlying calculation type for the AD evaluation. Needs to implement all mathematical functions.
+   * @tparam Gradient  The type of the derivative values for the AD evaluation. Needs to implement an addition and multiplication operation.
+   */
+  template<typename Real, typename Gradient = Real>
+  using RealReverseIndexSortedGen = ActiveReal<JacobiIndexTape<JacobiIndexTapeTypes<ReverseTapeTypes<Real, Gradient, SortedReuseIndexHandlerUseCount<int> >, ChunkVector> > >;
+
+  /**
+   * @brief A reverse type like the #RealReverseIndex but the freed indices are reused in ascending order.
+   *
+   * The #RealReverseIndex reuses the last freed index first, which spreads the live indices over the whole
+   * adjoint vector. This type reuses the smallest free index, such that the live indices stay dense. The
+   * "Index gaps" value in the tape statistics shows how many free indices are below the largest live index.
+   */
+  typedef RealReverseIndexSortedGen<double, double> RealReverseIndexSorted;
+
+  /**
+   * @brief The primal value reverse type in CoDiPack with a generalized calculation type and a generalized index type.
+   *
+   * See the documentation of #RealReversePrimal.
+   *
+   * @tparam     Real  The underlying calculation type for the AD evaluation. Needs to implement all mathematical functions.
+   * @tparam    Index  The type for the identification of the adjoint values. Needs to be an integral type.
+   * @tparam Gradient  The type of the derivative values for the AD evaluation. Needs to implement an addition and multiplication operation.
+   */
+  template<typename Real, typename Index, typename Gradient = Real>
+  using RealReversePrimalIdxGen = ActiveReal<PrimalValueTape<PrimalValueTapeTypes<ReverseTapeTypes<Real, Gradient, LinearIndexHandler<Index> >, StaticFunctionHandleFactory, ChunkVector> > >;
+
   /**
    * @brief The primal value reverse type in CoDiPack with a generalized calculation type.
    *
@@ -265,7 +427,7 @@ namespace codi {
    * @tparam Gradient  The type of the derivative values for the AD evaluation. Needs to implement an addition and multiplication operation.
    */
   template<typename Real, typename Gradient = Real>
-  using RealReversePrimalGen = ActiveReal<PrimalValueTape<PrimalValueTapeTypes<ReverseTapeTypes<Real, Gradient, LinearIndexHandler<int> >, StaticFunctionHandleFactory, ChunkVector> > >;
+  using RealReversePrimalGen = RealReversePrimalIdxGen<Real, int, Gradient>;
 
   /**
    * @brief A reverse type like the default reverse type in CoDiPack but with primal value taping instead of Jacobian taping.
@@ -277,6 +439,18 @@ namespace codi {
    */
   typedef RealReversePrimalGen<double, double> RealReversePrimal;
 
+  /**
+   * @brief The #RealReversePrimal type with 64 bit indices.
+   *
+   * The type can be used if more than 2^31 - 1 statements are recorded.
+   */
+  typedef RealReversePrimalIdxGen<double, int64_t> RealReversePrimal64;
+
+  /**
+   * @brief The #RealReversePrimal type with unsigned 32 bit indices.
+   */
+  typedef RealReversePrimalIdxGen<double, uint32_t> RealReversePrimalU32;
+
   /**
    * @brief Vector mode of the #RealReversePrimal type.
    *
@@ -308,15 +482,27 @@ namespace codi {
   typedef RealReversePrimalUncheckedGen<double, double> RealReversePrimalUnchecked;
 
   /**
-   * @brief The primal value reverse type in CoDiPack with an index management and with a generalized calculation type.
+   * @brief The primal value reverse type in CoDiPack with an index management and with a generalized calculation type and a generalized index type.
    *
    * See the documentation of #RealReversePrimal and #RealReverseIndex.
    *
    * @tparam     Real  The underlying calculation type for the AD evaluation. Needs to implement all mathematical functions.
+   * @tparam    Index  The type for the identification of the adjoint values. Needs to be an integral type.
+   * @tparam Gradient  The type of the derivative values for the AD evaluation. Needs to implement an addition and multiplication operation.
+   */
+  template<typename Real, typename Index, typename Gradient = Real>
+  using RealReversePrimalIndexIdxGen = ActiveReal<PrimalValueIndexTape<IndexPrimalValueTapeTypes<ReverseTapeTypes<Real, Gradient, ReuseIndexHandlerUseCount<Index> >, StaticObjectHandleFactory, ChunkVector > > >;
+
+  /**
+   * @brief The primal value reverse type in CoDiPack with an index management and with a generalized calculation type.
+   *
+   * See the documentation of #RealReversePrimalIndex.
+   *
+   * @tparam     Real  The underlying calculation type for the AD evaluation. Needs to implement all mathematical functions.
    * @tparam Gradient  The type of the derivative values for the AD evaluation. Needs to implement an addition and multiplication operation.
    */
   template<typename Real, typename Gradient = Real>
-  using RealReversePrimalIndexGen = ActiveReal<PrimalValueIndexTape<IndexPrimalValueTapeTypes<ReverseTapeTypes<Real, Gradient, ReuseIndexHandlerUseCount<int> >, StaticObjectHandleFactory, ChunkVector > > >;
+  using RealReversePrimalIndexGen = RealReversePrimalIndexIdxGen<Real, int, Gradient>;
 
 
   /**
@@ -326,6 +512,18 @@ namespace codi {
    */
   typedef RealReversePrimalIndexGen<double, double> RealReversePrimalIndex;
 
+  /**
+   * @brief The #RealReversePrimalIndex type with 64 bit indices.
+   *
+   * The type can be used if more than 2^31 - 1 variables are alive at the same time.
+   */
+  typedef RealReversePrimalIndexIdxGen<double, int64_t> RealReversePrimalIndex64;
+
+  /**
+   * @brief The #RealReversePrimalIndex type with unsigned 32 bit indices.
+   */
+  typedef RealReversePrimalIndexIdxGen<double, uint32_t> RealReversePrimalIndexU32;
+
   /**
    * @brief Vector mode of the #RealReversePrimalIndex type.
    *
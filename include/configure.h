@@ -145,6 +145,32 @@ namespace codi {
   static size_t DefaultChunkSize = CODI_ChunkSize;
   #undef CODI_ChunkSize
 
+  #ifndef CODI_SwapChunkMemory
+    #define CODI_SwapChunkMemory 1073741824
+  #endif
+  /**
+   * @brief Default number of bytes the swap chunks can keep in memory.
+   *
+   * Default is 1 Gb. If more memory is needed, the chunks are written to a scratch file.
+   *
+   * It can be set with the preprocessor macro CODI_SwapChunkMemory=<bytes>
+   */
+  static size_t DefaultSwapChunkMemory = CODI_SwapChunkMemory;
+  #undef CODI_SwapChunkMemory
+
+  #ifndef CODI_ChunkPoolMemory
+    #define CODI_ChunkPoolMemory 0
+  #endif
+  /**
+   * @brief Default number of bytes the chunk pool retains for later allocations.
+   *
+   * Default is 0, the memory of deleted chunks is released immediately.
+   *
+   * It can be set with the preprocessor macro CODI_ChunkPoolMemory=<bytes>
+   */
+  static size_t DefaultChunkPoolMemory = CODI_ChunkPoolMemory;
+  #undef CODI_ChunkPoolMemory
+
   #ifndef CODI_CheckExpressionArguments
     #define CODI_CheckExpressionArguments false
   #endif
@@ -204,6 +230,84 @@ namespace codi {
   const bool OptCheckZeroIndex = CODI_OptCheckZeroIndex;
   #undef CODI_OptCheckZeroIndex
 
+  #ifndef CODI_ImplicitUnitJacobies
+    #define CODI_ImplicitUnitJacobies false
+  #endif
+  /**
+   * @brief Jacobi tapes store the arguments with the jacobies 1.0 and -1.0 without their jacobi.
+   *
+   * The indices of these arguments are stored in a separate vector, the lowest bit of the entry holds the sign.
+   * Each statement stores the number of arguments in both vectors. The evaluation of the tape adds or subtracts
+   * the adjoints of the unit arguments without a multiplication. Arguments with an index that can not be shifted
+   * by one bit and the arguments pushed with pushJacobiManual keep their jacobi.
+   *
+   * It can be set with the preprocessor macro CODI_ImplicitUnitJacobies=<true/false>
+   */
+  const bool ImplicitUnitJacobies = CODI_ImplicitUnitJacobies;
+  #undef CODI_ImplicitUnitJacobies
+
+  #ifndef CODI_CheckIndexOverflow
+    #define CODI_CheckIndexOverflow true
+  #endif
+  /**
+   * @brief Check if the index handlers run out of the range of the index type.
+   *
+   * If the check is enabled an exception is raised when a new index can not be represented by the index type.
+   * Without the check the indices wrap around and the adjoint values are corrupted. Tapes with more statements
+   * than the range of int can use the types with 64 bit indices e.g. RealReverse64.
+   *
+   * It can be set with the preprocessor macro CODI_CheckIndexOverflow=<true/false>
+   */
+  const bool CheckIndexOverflow = CODI_CheckIndexOverflow;
+  #undef CODI_CheckIndexOverflow
+
+  #ifndef CODI_ZeroPageVectors
+    #define CODI_ZeroPageVectors false
+  #endif
+  /**
+   * @brief Allocate the adjoint and primal vectors of the tapes with anonymous memory mappings.
+   *
+   * The kernel provides zero pages for the entries which have not been touched, therefore the vectors of
+   * trivial types are not initialized by the tape. A growth of the vectors remaps the pages and does not copy
+   * the data. Only available on Linux, other systems use realloc.
+   *
+   * It can be set with the preprocessor macro CODI_ZeroPageVectors=<true/false>
+   */
+  const bool ZeroPageVectors = CODI_ZeroPageVectors;
+  #undef CODI_ZeroPageVectors
+
+  #ifndef CODI_ReleaseAdjointPages
+    #define CODI_ReleaseAdjointPages false
+  #endif
+  /**
+   * @brief Release the pages of the adjoint vector behind the reverse sweep of linear index tapes.
+   *
+   * The statements of a linear index tape only reference smaller indices, therefore an adjoint value is not
+   * used by the remaining evaluation once the sweep has passed its statement. The pages with such values are
+   * given back to the system, except for the ones with registered inputs. Only the evaluations with the
+   * adjoint vector of the tape release memory. Requires ZeroPageVectors and ZeroAdjointReverse.
+   *
+   * It can be set with the preprocessor macro CODI_ReleaseAdjointPages=<true/false>
+   */
+  const bool ReleaseAdjointPages = CODI_ReleaseAdjointPages;
+  #undef CODI_ReleaseAdjointPages
+
+  #ifndef CODI_SkipZeroAdjointChunks
+    #define CODI_SkipZeroAdjointChunks false
+  #endif
+  /**
+   * @brief Skip the chunks of linear index tapes in the reverse evaluation if all their lhs adjoints are zero.
+   *
+   * The evaluation marks coarse blocks of the adjoint vector which can contain nonzero values. A chunk of
+   * jacobies is not loaded if none of the blocks with its left hand side indices is marked. This reduces the
+   * evaluation to the relevant part of the tape if only a few outputs are seeded. The marking adds some work
+   * for each argument of a statement.
+   *
+   * It can be set with the preprocessor macro CODI_SkipZeroAdjointChunks=<true/false>
+   */
+  const bool SkipZeroAdjointChunks = CODI_SkipZeroAdjointChunks;
+  #undef CODI_SkipZeroAdjointChunks
+
   #ifndef CODI_OptCheckEmptyStatements
     #define CODI_OptCheckEmptyStatements true
   #endif
@@ -280,6 +384,22 @@ namespace codi {
   const bool OptDisableAssignOptimization = CODI_DisableAssignOptimization;
   #undef CODI_DisableAssignOptimization
 
+  #ifndef CODI_OptCopyElimination
+    #define CODI_OptCopyElimination false
+  #endif
+  /**
+   * @brief Removes statements which only copy the derivative of one argument in Jacobi tapes with a linear index handler.
+   *
+   * A statement with one argument and the jacobi 1.0, e.g. a = b + 2.0, has the same derivative as its argument.
+   * Instead of the statement, the lhs gets the index of the argument. Since the indices of a linear index
+   * handler are never reused, the index stays valid when one of the variables is overwritten. Variables
+   * with a shared index also share their adjoint value until registerOutput creates a new index.
+   *
+   * It can be set with the preprocessor macro CODI_OptCopyElimination=<true/false>
+   */
+  const bool OptCopyElimination = CODI_OptCopyElimination;
+  #undef CODI_OptCopyElimination
+
   /*
    * This switch enables the implict conversion operator to the primal value in the
    * active types.
@@ -318,6 +438,111 @@ namespace codi {
     #define PRIMAL_ADJOINT_TYPE GradientValue
   #endif
 
+  /*
+   * This switch enables the prefetching of swap chunks during the evaluation of the tape. While a chunk is
+   * evaluated, the next chunk in the evaluation order is read from the scratch file by a background thread.
+   *
+   * The switch requires the thread support of the C++11 standard library.
+   *
+   * It can be set with the preprocessor macro CODI_EnableSwapChunkPrefetch=<1/0>
+   */
+  #ifndef CODI_EnableSwapChunkPrefetch
+    #define CODI_EnableSwapChunkPrefetch 0
+  #endif
+
+  /*
+   * This switch enables the SIMD implementations of the Direction operations for double values. The instruction sets
+   * are selected from the compiler flags, e.g. -mavx2 -mfma or -mavx512f. SSE2 is used on all x86-64 targets.
+   *
+   * It can be set with the preprocessor macro CODI_EnableDirectionIntrinsics=<1/0>
+   */
+  #ifndef CODI_EnableDirectionIntrinsics
+    #define CODI_EnableDirectionIntrinsics 1
+  #endif
+
+  /*
+   * This switch fuses the scaled additions of the SIMD Direction operations into fused multiply adds. All elements,
+   * also the ones that are not handled by the SIMD instructions, are then computed with a single rounding. Without
+   * the switch all elements are computed with a separate multiplication and addition. The fused instructions are used
+   * with AVX-512 or with FMA support of the compiler flags, e.g. -mfma, otherwise std::fma is used.
+   *
+   * Without the switch, the compiler can still contract the separate operations if FMA instructions are available,
+   * e.g. GCC does so by default. The flag -ffp-contract=off prevents this.
+   *
+   * It can be set with the preprocessor macro CODI_EnableDirectionFMA=<1/0>
+   */
+  #ifndef CODI_EnableDirectionFMA
+    #define CODI_EnableDirectionFMA 0
+  #endif
+
+  /*
+   * This switch makes the global tapes of the active types thread local. Each thread records on its own tape, the
+   * index handlers of the index tapes are also created for each thread. The index handlers with index reuse take
+   * their new indices from a process wide range, such that the indices of the threads do not overlap. The recordings
+   * of the threads can be evaluated together with the TapeJoinHelper.
+   *
+   * Tapes with the linear index handler, e.g. RealReverse, can not be used with the switch, since each tape would
+   * number its statements from the same start. Values of different threads would then share their indices.
+   *
+   * The switch requires the thread_local support of the C++11 standard.
+   *
+   * It can be set with the preprocessor macro CODI_ThreadLocalTape=<1/0>
+   */
+  #ifndef CODI_ThreadLocalTape
+    #define CODI_ThreadLocalTape 0
+  #endif
+  #if CODI_ThreadLocalTape
+    #define CODI_TAPE_STORAGE thread_local
+  #else
+    #define CODI_TAPE_STORAGE /* the global tapes are shared by all threads */
+  #endif
+  /**
+   * @brief If the global tapes and their index handlers are created for each thread.
+   *
+   * It can be set with the preprocessor macro CODI_ThreadLocalTape=<1/0>
+   */
+  const bool ThreadLocalTape = CODI_ThreadLocalTape;
+
+  #ifndef CODI_PrefetchDistance
+    #define CODI_PrefetchDistance 0
+  #endif
+  /**
+   * @brief The distance of the software prefetches for the lhs adjoint values in the reverse evaluation.
+   *
+   * The index tapes prefetch the adjoint value of the lhs which is evaluated this many statements later. The lhs
+   * adjoint values of the linear index tapes are read sequentially and are not prefetched. A value of zero disables
+   * the prefetches.
+   *
+   * It can be set with the preprocessor macro CODI_PrefetchDistance=<unsigned integer>
+   */
+  const size_t PrefetchDistance = CODI_PrefetchDistance;
+  #undef CODI_PrefetchDistance
+
+  #ifndef CODI_PrefetchArgumentDistance
+    #define CODI_PrefetchArgumentDistance 0
+  #endif
+  /**
+   * @brief The distance of the software prefetches for the argument adjoint values in the reverse evaluation.
+   *
+   * The adjoint values of the arguments which are evaluated this many entries later in the index data are
+   * prefetched. A value of zero disables the prefetches.
+   *
+   * It can be set with the preprocessor macro CODI_PrefetchArgumentDistance=<unsigned integer>
+   */
+  const size_t PrefetchArgumentDistance = CODI_PrefetchArgumentDistance;
+  #undef CODI_PrefetchArgumentDistance
+
+  /**
+   * @brief Macro for a software prefetch of the cache line of the address for a write access.
+   *
+   * Currently it is defined for gcc compatible compilers, otherwise the prefetch is omitted.
+   */
+  #if defined(__GNUC__)
+    #define CODI_PREFETCH(address) __builtin_prefetch((address), 1)
+  #else
+    #define CODI_PREFETCH(address) (void)(address)
+  #endif
+
   /*
    * This disable the special implementations for the gradients in the binary operators.
    *
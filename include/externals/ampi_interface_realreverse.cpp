@@ -55,7 +55,7 @@ extern "C" {
 
 
   void ampi_get_adj(INT64 *idx, double *x) {
-    int index = *idx;
+    type::GradientData index = (type::GradientData)*idx;
     if(index!=0) {
         *x = type::getGlobalTape().getGradient(index);
         type::getGlobalTape().setGradient(index, 0.0);
@@ -64,7 +64,7 @@ extern "C" {
     }
   }
   void ampi_set_adj(INT64 *idx, double *x) {
-   int index = *idx;
+   type::GradientData index = (type::GradientData)*idx;
     if(*idx!=0 && *x != 0.0){
         type::getGlobalTape().gradient(index) += *x;
     }
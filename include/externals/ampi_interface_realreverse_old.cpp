@@ -64,7 +64,7 @@ extern "C" {
 
   }
   void ampi_set_adj(INT64 *idx, double *x) {
-   int index = *idx;
+   type::GradientData index = (type::GradientData)*idx;
     if(*idx!=0 && *x != 0.0){
         type::getGlobalTape().gradient(index) += *x;
     }
@@ -0,0 +1,131 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "../configure.h"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief A coarse summary of the adjoint vector which marks the blocks that might contain nonzero values.
+   *
+   * Each block covers 2^BlockBits consecutive indices. Unmarked blocks contain only zero adjoint values,
+   * therefore the evaluation of statements with left hand sides in such blocks can be skipped.
+   *
+   * @tparam Index  The type for the indices of the adjoint vector.
+   */
+  template<typename Index>
+  struct AdjointBlockSummary {
+
+      /** @brief The number of indices in one block is 2^BlockBits. */
+      static const size_t BlockBits = 10;
+
+    private:
+
+      std::vector<unsigned char> blocks; /**< One entry per block, nonzero if the block is marked. */
+
+    public:
+
+      /**
+       * @brief Creates an empty summary.
+       */
+      AdjointBlockSummary() :
+        blocks() {}
+
+      /**
+       * @brief Remove all marks and set the size of the summary.
+       *
+       * @param[in] size  The size of the adjoint vector.
+       */
+      void reset(const size_t size) {
+        blocks.assign((size >> BlockBits) + 1, 0);
+      }
+
+      /**
+       * @brief Mark the block of the index.
+       *
+       * @param[in] index  The index of a possibly nonzero adjoint value.
+       */
+      CODI_INLINE void mark(const Index& index) {
+        blocks[(size_t)index >> BlockBits] = 1;
+      }
+
+      /**
+       * @brief Mark all blocks which contain indices in the range [low, high].
+       *
+       * Indices outside of the size of the summary are ignored.
+       *
+       * @param[in]  low  The first index of the range.
+       * @param[in] high  The last index of the range.
+       */
+      void markRange(const Index& low, const Index& high) {
+        if(low <= high) {
+          size_t lowBlock = (size_t)low >> BlockBits;
+          size_t highBlock = std::min((size_t)high >> BlockBits, blocks.size() - 1);
+          for(size_t block = lowBlock; block <= highBlock; ++block) {
+            blocks[block] = 1;
+          }
+        }
+      }
+
+      /**
+       * @brief Check if all blocks with indices in the range (low, high] are unmarked.
+       *
+       * @param[in]  low  The index before the range.
+       * @param[in] high  The last index of the range.
+       *
+       * @return true if all adjoint values in the range are zero.
+       */
+      bool isZero(const Index& low, const Index& high) const {
+        if(high <= low) {
+          return true;
+        }
+
+        size_t lowBlock = ((size_t)low + 1) >> BlockBits;
+        size_t highBlock = (size_t)high >> BlockBits;
+        if(highBlock >= blocks.size()) {
+          return false;
+        }
+        for(size_t block = lowBlock; block <= highBlock; ++block) {
+          if(0 != blocks[block]) {
+            return false;
+          }
+        }
+
+        return true;
+      }
+  };
+}
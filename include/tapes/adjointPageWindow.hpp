@@ -0,0 +1,134 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "../configure.h"
+#include "zeroPageArray.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Releases the pages of the adjoint vector behind the reverse sweep of a linear index tape.
+   *
+   * The statements of linear index tapes only have arguments with smaller indices than their left hand side.
+   * After the sweep has evaluated a statement, the adjoint value of its left hand side is reset and not used
+   * again in the evaluation. The only values which are still needed are the ones of registered inputs, since
+   * they are read after the evaluation.
+   *
+   * The window collects the evaluated indices above the sweep up to the next input. The full pages of this
+   * range are released if the range is large enough or an input is reached. See ReleaseAdjointPages for the
+   * requirements.
+   *
+   * @tparam GradientValue  The type of the entries in the adjoint vector.
+   */
+  template<typename GradientValue>
+  struct AdjointPageWindow {
+
+      /** @brief Indicates if pages can be released with the current configuration. */
+      static const bool Enabled = ReleaseAdjointPages && ZeroAdjointReverse &&
+                                  ZeroPageArray<GradientValue>::UseMapping && std::is_trivial<GradientValue>::value;
+
+      /** @brief The number of evaluated entries after which the pages are released. */
+      static const size_t ReleaseInterval = ZeroPageArray<GradientValue>::ReleaseThreshold / sizeof(GradientValue);
+
+    private:
+
+      GradientValue* adjoints; /**< The adjoint vector of the tape. */
+      size_t releaseEnd; /**< The entry after the range of evaluated entries which are not released yet. */
+
+    public:
+
+      /**
+       * @brief Creates a window for one reverse evaluation.
+       *
+       * The window is a local object of the evaluation and may only be used if the evaluation runs on the
+       * adjoint vector of the tape, see isApplicable.
+       *
+       * @param[in]   adjoints  The adjoint vector of the tape.
+       * @param[in] startIndex  The largest lhs index in the evaluated range.
+       */
+      AdjointPageWindow(GradientValue* adjoints, const size_t startIndex) :
+        adjoints(adjoints),
+        releaseEnd(startIndex + 1) {}
+
+      /**
+       * @brief Check if a window can be used for the evaluation.
+       *
+       * Evaluations with other adjoint vectors, e.g. the ones of the ConcurrentEvaluationHelper, must not release
+       * any pages since the tape is only read during them.
+       *
+       * @param[in] tapeAdjoints  The adjoint vector of the tape.
+       * @param[in]  adjointData  The adjoint vector of the evaluation.
+       *
+       * @return true if pages can be released and the evaluation uses the adjoint vector of the tape.
+       *
+       * @tparam AdjointData  The type of the entries in the adjoint vector of the evaluation.
+       */
+      template<typename AdjointData>
+      static bool isApplicable(const GradientValue* tapeAdjoints, const AdjointData* adjointData) {
+        return Enabled && (const void*)tapeAdjoints == (const void*)adjointData;
+      }
+
+      /**
+       * @brief Called after the statement of the index has been evaluated.
+       *
+       * @param[in]   index  The lhs index of the statement.
+       * @param[in] isInput  If the statement is a registered input.
+       */
+      CODI_INLINE void evaluated(const size_t index, const bool isInput) {
+        if(Enabled) {
+          if(isInput) {
+            ZeroPageArray<GradientValue>::releasePages(adjoints, index + 1, releaseEnd);
+            releaseEnd = index;
+          } else if(releaseEnd - index >= ReleaseInterval) {
+            ZeroPageArray<GradientValue>::releasePages(adjoints, index, releaseEnd);
+            releaseEnd = index;
+          }
+        }
+      }
+
+      /**
+       * @brief Release the remaining range of the evaluation.
+       *
+       * @param[in] endIndex  The index before the smallest lhs index in the evaluated range.
+       */
+      void finish(const size_t endIndex) {
+        if(Enabled) {
+          ZeroPageArray<GradientValue>::releasePages(adjoints, endIndex + 1, releaseEnd);
+          releaseEnd = endIndex + 1;
+        }
+      }
+  };
+}
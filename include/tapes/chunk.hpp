@@ -33,6 +33,7 @@
 
 #include "../configure.h"
 #include "../tools/io.hpp"
+#include "chunkAllocators.hpp"
 
 /**
  * @brief Global namespace for CoDiPack - Code Differentiation Package
@@ -48,6 +49,13 @@ namespace codi {
    */
   struct ChunkInterface {
 
+    /**
+     * @brief If several threads can read the chunk at the same time.
+     *
+     * This is the case if load() and store() do not modify the chunk.
+     */
+    static const bool ConcurrentRead = true;
+
     size_t size; /**< Size of the allocated data */
     size_t usedSize; /**< Number of used items in the data array */
 
@@ -156,6 +164,22 @@ namespace codi {
      * evaluation process.
      */
     CODI_INLINE void load() {}
+
+    /**
+     * @brief Prepare the loading of the data of the chunk.
+     *
+     * This method is called when the data of the chunk will be needed next by the
+     * evaluation process. The data can be loaded in the background until load is called.
+     */
+    CODI_INLINE void prefetch() {}
+
+    /**
+     * @brief Mark the data of the chunk as changed.
+     *
+     * This method is called after the data of the chunk is loaded and before it is modified outside of
+     * the recording.
+     */
+    CODI_INLINE void setModified() {}
   };
 
   /**
@@ -163,10 +187,11 @@ namespace codi {
    *
    * This chunk contains one data array which is stored in memory.
    *
-   * @tparam Data   The type of the stored data.
+   * @tparam      Data  The type of the stored data.
+   * @tparam Allocator  The allocator policy for the data arrays, see ChunkAllocatorBase.
    */
-  template<typename Data>
-  struct Chunk1 final : public ChunkInterface {
+  template<typename Data, typename Allocator = PoolChunkAllocator>
+  struct Chunk1 : public ChunkInterface {
 
     /**
      * @brief The combined size of one entry in all data arrays.
@@ -220,7 +245,7 @@ namespace codi {
      */
     void allocateData() {
       if(NULL == data) {
-        data = new Data[size];
+        data = Allocator::template allocateArray<Data>(size);
       }
     }
 
@@ -229,7 +254,7 @@ namespace codi {
      */
     void deleteData() {
       if(NULL != data) {
-        delete [] data;
+        Allocator::deleteArray(data, size);
         data = NULL;
       }
     }
@@ -239,7 +264,7 @@ namespace codi {
      *
      * @param[in,out] other The chunk for the data swap.
      */
-    void swap(Chunk1<Data>& other) {
+    void swap(Chunk1<Data, Allocator>& other) {
       this->swapBase(other);
 
       std::swap(data, other.data);
@@ -281,11 +306,12 @@ namespace codi {
    *
    * This chunk contains two data arrays which are stored in memory.
    *
-   * @tparam Data1   The first type of the stored data.
-   * @tparam Data2   The second type of the stored data.
+   * @tparam     Data1  The first type of the stored data.
+   * @tparam     Data2  The second type of the stored data.
+   * @tparam Allocator  The allocator policy for the data arrays, see ChunkAllocatorBase.
    */
-  template<typename Data1, typename Data2>
-  struct Chunk2 final : public ChunkInterface {
+  template<typename Data1, typename Data2, typename Allocator = PoolChunkAllocator>
+  struct Chunk2 : public ChunkInterface {
 
     /**
      * @brief The combined size of one entry in all data arrays.
@@ -342,11 +368,11 @@ namespace codi {
      */
     void allocateData() {
       if(NULL == data1) {
-        data1 = new Data1[size];
+        data1 = Allocator::template allocateArray<Data1>(size);
       }
 
       if(NULL == data2) {
-        data2 = new Data2[size];
+        data2 = Allocator::template allocateArray<Data2>(size);
       }
     }
 
@@ -355,12 +381,12 @@ namespace codi {
      */
     void deleteData() {
       if(NULL != data1) {
-        delete [] data1;
+        Allocator::deleteArray(data1, size);
         data1 = NULL;
       }
 
       if(NULL != data2) {
-        delete [] data2;
+        Allocator::deleteArray(data2, size);
         data2 = NULL;
       }
     }
@@ -370,7 +396,7 @@ namespace codi {
      *
      * @param[in,out] other The chunk for the data swap.
      */
-    void swap(Chunk2<Data1, Data2>& other) {
+    void swap(Chunk2<Data1, Data2, Allocator>& other) {
       this->swapBase(other);
 
       std::swap(data1, other.data1);
@@ -417,12 +443,13 @@ namespace codi {
    *
    * This chunk contains three data arrays which are stored in memory.
    *
-   * @tparam Data1   The first type of the stored data.
-   * @tparam Data2   The second type of the stored data.
-   * @tparam Data3   The third type of the stored data.
+   * @tparam     Data1  The first type of the stored data.
+   * @tparam     Data2  The second type of the stored data.
+   * @tparam     Data3  The third type of the stored data.
+   * @tparam Allocator  The allocator policy for the data arrays, see ChunkAllocatorBase.
    */
-  template<typename Data1, typename Data2, typename Data3>
-  struct Chunk3 final : public ChunkInterface {
+  template<typename Data1, typename Data2, typename Data3, typename Allocator = PoolChunkAllocator>
+  struct Chunk3 : public ChunkInterface {
 
     /**
      * @brief The combined size of one entry in all data arrays.
@@ -486,15 +513,15 @@ namespace codi {
      */
     void allocateData() {
       if(NULL == data1) {
-        data1 = new Data1[size];
+        data1 = Allocator::template allocateArray<Data1>(size);
       }
 
       if(NULL == data2) {
-        data2 = new Data2[size];
+        data2 = Allocator::template allocateArray<Data2>(size);
       }
 
       if(NULL == data3) {
-        data3 = new Data3[size];
+        data3 = Allocator::template allocateArray<Data3>(size);
       }
     }
 
@@ -503,17 +530,17 @@ namespace codi {
      */
     void deleteData() {
       if(NULL != data1) {
-        delete [] data1;
+        Allocator::deleteArray(data1, size);
         data1 = NULL;
       }
 
       if(NULL != data2) {
-        delete [] data2;
+        Allocator::deleteArray(data2, size);
         data2 = NULL;
       }
 
       if(NULL != data3) {
-        delete [] data3;
+        Allocator::deleteArray(data3, size);
         data3 = NULL;
       }
     }
@@ -523,7 +550,7 @@ namespace codi {
      *
      * @param[in,out] other The chunk for the data swap.
      */
-    void swap(Chunk3<Data1, Data2, Data3>& other) {
+    void swap(Chunk3<Data1, Data2, Data3, Allocator>& other) {
       this->swapBase(other);
 
       std::swap(data1, other.data1);
@@ -575,13 +602,14 @@ namespace codi {
    *
    * This chunk contains four data arrays which are stored in memory.
    *
-   * @tparam Data1   The first type of the stored data.
-   * @tparam Data2   The second type of the stored data.
-   * @tparam Data3   The third type of the stored data.
-   * @tparam Data4   The fourth type of the stored data.
+   * @tparam     Data1  The first type of the stored data.
+   * @tparam     Data2  The second type of the stored data.
+   * @tparam     Data3  The third type of the stored data.
+   * @tparam     Data4  The fourth type of the stored data.
+   * @tparam Allocator  The allocator policy for the data arrays, see ChunkAllocatorBase.
    */
-  template<typename Data1, typename Data2, typename Data3, typename Data4>
-  struct Chunk4 final : public ChunkInterface {
+  template<typename Data1, typename Data2, typename Data3, typename Data4, typename Allocator = PoolChunkAllocator>
+  struct Chunk4 : public ChunkInterface {
 
     /**
      * @brief The combined size of one entry in all data arrays.
@@ -649,19 +677,19 @@ namespace codi {
      */
     void allocateData() {
       if(NULL == data1) {
-        data1 = new Data1[size];
+        data1 = Allocator::template allocateArray<Data1>(size);
       }
 
       if(NULL == data2) {
-        data2 = new Data2[size];
+        data2 = Allocator::template allocateArray<Data2>(size);
       }
 
       if(NULL == data3) {
-        data3 = new Data3[size];
+        data3 = Allocator::template allocateArray<Data3>(size);
       }
 
       if(NULL == data4) {
-        data4 = new Data4[size];
+        data4 = Allocator::template allocateArray<Data4>(size);
       }
     }
 
@@ -670,22 +698,22 @@ namespace codi {
      */
     void deleteData() {
       if(NULL != data1) {
-        delete [] data1;
+        Allocator::deleteArray(data1, size);
         data1 = NULL;
       }
 
       if(NULL != data2) {
-        delete [] data2;
+        Allocator::deleteArray(data2, size);
         data2 = NULL;
       }
 
       if(NULL != data3) {
-        delete [] data3;
+        Allocator::deleteArray(data3, size);
         data3 = NULL;
       }
 
       if(NULL != data4) {
-        delete [] data4;
+        Allocator::deleteArray(data4, size);
         data4 = NULL;
       }
     }
@@ -695,7 +723,7 @@ namespace codi {
      *
      * @param[in,out] other The chunk for the data swap.
      */
-    void swap(Chunk4<Data1, Data2, Data3, Data4>& other) {
+    void swap(Chunk4<Data1, Data2, Data3, Data4, Allocator>& other) {
       this->swapBase(other);
 
       std::swap(data1, other.data1);
@@ -747,4 +775,71 @@ namespace codi {
     }
   };
 
+
+  /**
+   * @brief Changes the allocator policy of a chunk type.
+   *
+   * @tparam         Chunk  One of the chunks Chunk1, Chunk2, Chunk3 or Chunk4.
+   * @tparam NewAllocator  The allocator policy for the new chunk type.
+   */
+  template<typename Chunk, typename NewAllocator>
+  struct ChunkAllocatorRebind;
+
+  /**
+   * @brief Specialization for Chunk1.
+   *
+   * @tparam         Data1  The first data type for the chunk.
+   * @tparam     Allocator  The current allocator policy.
+   * @tparam  NewAllocator  The new allocator policy.
+   */
+  template<typename Data1, typename Allocator, typename NewAllocator>
+  struct ChunkAllocatorRebind<Chunk1<Data1, Allocator>, NewAllocator> {
+    /** @brief The chunk with the new allocator. */
+    typedef Chunk1<Data1, NewAllocator> Type;
+  };
+
+  /**
+   * @brief Specialization for Chunk2.
+   *
+   * @tparam         Data1  The first data type for the chunk.
+   * @tparam         Data2  The second data type for the chunk.
+   * @tparam     Allocator  The current allocator policy.
+   * @tparam  NewAllocator  The new allocator policy.
+   */
+  template<typename Data1, typename Data2, typename Allocator, typename NewAllocator>
+  struct ChunkAllocatorRebind<Chunk2<Data1, Data2, Allocator>, NewAllocator> {
+    /** @brief The chunk with the new allocator. */
+    typedef Chunk2<Data1, Data2, NewAllocator> Type;
+  };
+
+  /**
+   * @brief Specialization for Chunk3.
+   *
+   * @tparam         Data1  The first data type for the chunk.
+   * @tparam         Data2  The second data type for the chunk.
+   * @tparam         Data3  The third data type for the chunk.
+   * @tparam     Allocator  The current allocator policy.
+   * @tparam  NewAllocator  The new allocator policy.
+   */
+  template<typename Data1, typename Data2, typename Data3, typename Allocator, typename NewAllocator>
+  struct ChunkAllocatorRebind<Chunk3<Data1, Data2, Data3, Allocator>, NewAllocator> {
+    /** @brief The chunk with the new allocator. */
+    typedef Chunk3<Data1, Data2, Data3, NewAllocator> Type;
+  };
+
+  /**
+   * @brief Specialization for Chunk4.
+   *
+   * @tparam         Data1  The first data type for the chunk.
+   * @tparam         Data2  The second data type for the chunk.
+   * @tparam         Data3  The third data type for the chunk.
+   * @tparam         Data4  The fourth data type for the chunk.
+   * @tparam     Allocator  The current allocator policy.
+   * @tparam  NewAllocator  The new allocator policy.
+   */
+  template<typename Data1, typename Data2, typename Data3, typename Data4, typename Allocator, typename NewAllocator>
+  struct ChunkAllocatorRebind<Chunk4<Data1, Data2, Data3, Data4, Allocator>, NewAllocator> {
+    /** @brief The chunk with the new allocator. */
+    typedef Chunk4<Data1, Data2, Data3, Data4, NewAllocator> Type;
+  };
 }
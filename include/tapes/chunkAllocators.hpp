@@ -0,0 +1,320 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+
+#if defined(__linux__)
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
+#include "../configure.h"
+#include "chunkPool.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Creates and deletes the data arrays of the chunks with the raw memory of an allocator policy.
+   *
+   * An allocator policy needs to provide the static functions
+   * \code{.cpp}
+   *   static void* allocate(const size_t& bytes);
+   *   static void release(void* block, const size_t& bytes);
+   * \endcode
+   * and derive from this class. The memory is not initialized for trivial types, all other types are
+   * default constructed.
+   *
+   * @tparam Impl  The allocator policy.
+   */
+  template<typename Impl>
+  struct ChunkAllocatorBase {
+
+    /**
+     * @brief Allocate a data array for a chunk.
+     *
+     * @param[in] size  The number of items in the array.
+     *
+     * @return The data array.
+     *
+     * @tparam Data  The type of the items.
+     */
+    template<typename Data>
+    static Data* allocateArray(const size_t& size) {
+      Data* data = static_cast<Data*>(Impl::allocate(size * sizeof(Data)));
+
+      if(!std::is_trivial<Data>::value) {
+        for(size_t i = 0; i < size; ++i) {
+          new (&data[i]) Data();
+        }
+      }
+
+      return data;
+    }
+
+    /**
+     * @brief Delete a data array from allocateArray.
+     *
+     * @param[in] data  The data array.
+     * @param[in] size  The number of items in the array.
+     *
+     * @tparam Data  The type of the items.
+     */
+    template<typename Data>
+    static void deleteArray(Data* data, const size_t& size) {
+      if(!std::is_trivially_destructible<Data>::value) {
+        for(size_t i = 0; i < size; ++i) {
+          data[i].~Data();
+        }
+      }
+
+      Impl::release(static_cast<void*>(data), size * sizeof(Data));
+    }
+  };
+
+  /**
+   * @brief The default allocator for the chunks, takes the memory from the global ChunkPool.
+   */
+  struct PoolChunkAllocator : public ChunkAllocatorBase<PoolChunkAllocator> {
+
+    /**
+     * @brief Get a block of uninitialized memory.
+     *
+     * @param[in] bytes  The size of the block.
+     *
+     * @return The memory block.
+     */
+    static void* allocate(const size_t& bytes) {
+      return ChunkPool::getGlobal().allocate(bytes);
+    }
+
+    /**
+     * @brief Release a block from allocate.
+     *
+     * @param[in] block  The memory block.
+     * @param[in] bytes  The size of the block.
+     */
+    static void release(void* block, const size_t& bytes) {
+      ChunkPool::getGlobal().release(block, bytes);
+    }
+  };
+
+  /**
+   * @brief Allocator for chunks with aligned data arrays.
+   *
+   * The default alignment is the size of a cache line, such that no cache line is shared by two arrays.
+   *
+   * @tparam Alignment  The alignment of the arrays in bytes. Needs to be a power of two.
+   */
+  template<size_t Alignment = 64>
+  struct AlignedChunkAllocator : public ChunkAllocatorBase<AlignedChunkAllocator<Alignment> > {
+
+    static_assert(0 == (Alignment & (Alignment - 1)) && Alignment >= sizeof(void*), "Alignment needs to be a power of two.");
+
+    /**
+     * @brief Get a block of uninitialized memory.
+     *
+     * @param[in] bytes  The size of the block.
+     *
+     * @return The memory block.
+     */
+    static void* allocate(const size_t& bytes) {
+      void* block = NULL;
+#if defined(_WIN32)
+      block = _aligned_malloc(bytes, Alignment);
+#else
+      if(0 != posix_memalign(&block, Alignment, bytes)) {
+        block = NULL;
+      }
+#endif
+      if(NULL == block) {
+        throw std::bad_alloc();
+      }
+
+      return block;
+    }
+
+    /**
+     * @brief Release a block from allocate.
+     *
+     * @param[in] block  The memory block.
+     * @param[in] bytes  The size of the block.
+     */
+    static void release(void* block, const size_t& bytes) {
+      CODI_UNUSED(bytes);
+#if defined(_WIN32)
+      _aligned_free(block);
+#else
+      free(block);
+#endif
+    }
+  };
+
+  /**
+   * @brief Allocator for chunks with transparent huge pages.
+   *
+   * The arrays are mapped on 2 MiB boundaries and the kernel is advised to use huge pages for them
+   * (madvise with MADV_HUGEPAGE). The default chunk size with 2097152 entries is a multiple of the huge
+   * page size, therefore the arrays of the default chunks cover only full huge pages. Fewer pages reduce
+   * the TLB misses during the evaluation of the tape.
+   *
+   * On systems other than Linux the arrays are only aligned to 2 MiB.
+   */
+  struct HugePageChunkAllocator : public ChunkAllocatorBase<HugePageChunkAllocator> {
+
+    /** @brief The size of a huge page in bytes. */
+    static const size_t HugePageSize = 2097152;
+
+    /**
+     * @brief Round the size up to full huge pages.
+     *
+     * @param[in] bytes  The requested size.
+     *
+     * @return The size of the mapping.
+     */
+    static size_t mappingSize(const size_t& bytes) {
+      return (bytes + HugePageSize - 1) / HugePageSize * HugePageSize;
+    }
+
+    /**
+     * @brief Get a block of uninitialized memory.
+     *
+     * @param[in] bytes  The size of the block.
+     *
+     * @return The memory block.
+     */
+    static void* allocate(const size_t& bytes) {
+#if defined(__linux__)
+      size_t size = mappingSize(bytes);
+
+      // map one page more and remove the unaligned parts
+      void* mapping = mmap(NULL, size + HugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if(MAP_FAILED == mapping) {
+        throw std::bad_alloc();
+      }
+
+      uintptr_t start = (uintptr_t)mapping;
+      uintptr_t alignedStart = (start + HugePageSize - 1) / HugePageSize * HugePageSize;
+      if(alignedStart != start) {
+        munmap(mapping, alignedStart - start);
+      }
+      uintptr_t end = start + size + HugePageSize;
+      uintptr_t alignedEnd = alignedStart + size;
+      if(alignedEnd != end) {
+        munmap((void*)alignedEnd, end - alignedEnd);
+      }
+
+  #if defined(MADV_HUGEPAGE)
+      madvise((void*)alignedStart, size, MADV_HUGEPAGE); // only a hint, errors are ignored
+  #endif
+
+      return (void*)alignedStart;
+#else
+      return AlignedChunkAllocator<HugePageSize>::allocate(bytes);
+#endif
+    }
+
+    /**
+     * @brief Release a block from allocate.
+     *
+     * @param[in] block  The memory block.
+     * @param[in] bytes  The size of the block.
+     */
+    static void release(void* block, const size_t& bytes) {
+#if defined(__linux__)
+      munmap(block, mappingSize(bytes));
+#else
+      AlignedChunkAllocator<HugePageSize>::release(block, bytes);
+#endif
+    }
+  };
+
+  /**
+   * @brief Allocator for chunks which touches the memory in the allocating thread.
+   *
+   * The operating systems place a page on the NUMA node of the thread that first writes to the page.
+   * The allocator writes to all pages of the array when the chunk is created, which happens on the
+   * recording thread. The memory is not taken from the ChunkPool, since the retained memory can be placed
+   * on any node.
+   */
+  struct FirstTouchChunkAllocator : public ChunkAllocatorBase<FirstTouchChunkAllocator> {
+
+    /**
+     * @brief Get a block of memory and write to every page of the block.
+     *
+     * @param[in] bytes  The size of the block.
+     *
+     * @return The memory block.
+     */
+    static void* allocate(const size_t& bytes) {
+      char* block = static_cast<char*>(AlignedChunkAllocator<64>::allocate(bytes));
+
+      size_t pageSize = getPageSize();
+      for(size_t pos = 0; pos < bytes; pos += pageSize) {
+        block[pos] = 0;
+      }
+
+      return block;
+    }
+
+    /**
+     * @brief Release a block from allocate.
+     *
+     * @param[in] block  The memory block.
+     * @param[in] bytes  The size of the block.
+     */
+    static void release(void* block, const size_t& bytes) {
+      AlignedChunkAllocator<64>::release(block, bytes);
+    }
+
+  private:
+
+    /**
+     * @brief The page size of the system.
+     *
+     * @return The page size in bytes, 4096 if it can not be determined.
+     */
+    static size_t getPageSize() {
+#if defined(__linux__)
+      long pageSize = sysconf(_SC_PAGESIZE);
+      if(0 < pageSize) {
+        return (size_t)pageSize;
+      }
+#endif
+      return 4096;
+    }
+  };
+}
@@ -0,0 +1,192 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <new>
+
+#include "../configure.h"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Process wide pool for the memory of the chunk data.
+   *
+   * All chunks allocate the memory for their data arrays from the global pool. Released arrays are kept
+   * in the pool until the retained memory would exceed the limit of the pool. A later allocation with
+   * the same size reuses the retained memory. Since the memory has already been touched, no new pages need to
+   * be requested from the operating system, which makes a re-recording after resetHard much cheaper.
+   *
+   * The default limit is zero, that is resetHard releases all memory to the operating system. The limit
+   * can be set with setMemoryLimit or with the preprocessor macro CODI_ChunkPoolMemory.
+   *
+   * The chunks use the pool through the PoolChunkAllocator.
+   */
+  struct ChunkPool {
+    private:
+
+      std::multimap<size_t, void*> freeBlocks; /**< Maps the size of the retained blocks to the memory. */
+
+      size_t memoryLimit; /**< The number of bytes the pool can retain. */
+      size_t memoryRetained; /**< The number of bytes the pool currently retains. */
+
+      std::mutex mutex; /**< Guards the access from several tapes. */
+
+    public:
+
+      /**
+       * @brief Create an empty pool with the default limit.
+       */
+      ChunkPool() :
+        freeBlocks(),
+        memoryLimit(DefaultChunkPoolMemory),
+        memoryRetained(0),
+        mutex() {}
+
+      /**
+       * @brief Releases all retained memory.
+       */
+      ~ChunkPool() {
+        clear();
+      }
+
+      /**
+       * @brief The pool which is used by all chunks.
+       *
+       * @return The global pool.
+       */
+      static ChunkPool& getGlobal() {
+        static ChunkPool pool;
+
+        return pool;
+      }
+
+      /**
+       * @brief Set the number of bytes the pool can retain.
+       *
+       * Retained memory above the new limit is released.
+       *
+       * @param[in] limit  The new limit in bytes.
+       */
+      void setMemoryLimit(const size_t& limit) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        memoryLimit = limit;
+
+        std::multimap<size_t, void*>::iterator pos = freeBlocks.begin();
+        while(memoryRetained > memoryLimit && freeBlocks.end() != pos) {
+          memoryRetained -= pos->first;
+          ::operator delete(pos->second);
+          pos = freeBlocks.erase(pos);
+        }
+      }
+
+      /**
+       * @brief Get the number of bytes the pool can retain.
+       *
+       * @return The limit in bytes.
+       */
+      size_t getMemoryLimit() const {
+        return memoryLimit;
+      }
+
+      /**
+       * @brief Get the number of bytes the pool currently retains.
+       *
+       * @return The retained memory in bytes.
+       */
+      size_t getMemoryRetained() const {
+        return memoryRetained;
+      }
+
+      /**
+       * @brief Release all retained memory to the operating system.
+       */
+      void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for(std::multimap<size_t, void*>::iterator pos = freeBlocks.begin(); pos != freeBlocks.end(); ++pos) {
+          ::operator delete(pos->second);
+        }
+        freeBlocks.clear();
+        memoryRetained = 0;
+      }
+
+      /**
+       * @brief Get a block of memory from the pool or from the operating system.
+       *
+       * @param[in] bytes  The size of the block.
+       *
+       * @return The uninitialized memory.
+       */
+      void* allocate(const size_t& bytes) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+
+          std::multimap<size_t, void*>::iterator pos = freeBlocks.find(bytes);
+          if(freeBlocks.end() != pos) {
+            void* block = pos->second;
+            memoryRetained -= bytes;
+            freeBlocks.erase(pos);
+
+            return block;
+          }
+        }
+
+        return ::operator new(bytes);
+      }
+
+      /**
+       * @brief Return a block of memory to the pool.
+       *
+       * The block is released to the operating system if the limit of the pool would be exceeded.
+       *
+       * @param[in] block  The memory from allocate.
+       * @param[in] bytes  The size of the block.
+       */
+      void release(void* block, const size_t& bytes) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+
+          if(memoryRetained + bytes <= memoryLimit) {
+            freeBlocks.insert(std::make_pair(bytes, block));
+            memoryRetained += bytes;
+
+            return;
+          }
+        }
+
+        ::operator delete(block);
+      }
+  };
+}
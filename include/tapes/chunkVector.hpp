@@ -246,6 +246,7 @@ namespace codi {
       } else {
         curChunk = chunks[curChunkIndex];
         curChunk->reset();
+        curChunk->load();
         positions[curChunkIndex] = nested->getPosition();
       }
     }
@@ -346,6 +347,16 @@ namespace codi {
       return curChunk->getUsedSize();
     }
 
+    /**
+     * @brief Set the pointers of the handle to the data items at a position in the current chunk.
+     *
+     * @param[in]     pos  The position inside the data of the current chunk.
+     * @param[out] handle  The handle which is set to the data items.
+     */
+    CODI_INLINE void getDataPointer(const size_t& pos, PointerHandle<ChunkType>& handle) {
+      handle.setPointers(pos, curChunk);
+    }
+
     /**
      * @brief Get the position of the chunk vector and the nested vectors.
      * @return The position of the chunk vector.
@@ -392,6 +403,51 @@ namespace codi {
     }
 
   private:
+
+    /**
+     * @brief Stores a chunk after its data was read.
+     *
+     * The current chunk is not stored since it is still used for the recording.
+     *
+     * @param chunkPos  The position of the chunk.
+     */
+    CODI_INLINE void storeReadChunk(const size_t& chunkPos) {
+      if(chunkPos != curChunkIndex) {
+        chunks[chunkPos]->store();
+      }
+    }
+
+    /**
+     * @brief Iterates over all data entries in the given range.
+     *
+     * It has to hold start >= end.
+     *
+     * @param    start  The starting point of the range.
+     * @param      end  The end point of the range.
+     * @param   modify  If the function modifies the data of the chunks.
+     * @param function  The function called for each data entry.
+     * @param     args  Additional arguments for the function.
+     *
+     * @tparam  Args  The data types for the arguments.
+     */
+    template<typename FunctionObject, typename ... Args>
+    CODI_INLINE void forEachRangeReverse(const Position& start, const Position& end, const bool modify, FunctionObject& function, Args&&... args) {
+      codiAssert(start.chunk > end.chunk || (start.chunk == end.chunk && start.data >= end.data));
+      codiAssert(start.chunk < chunks.size());
+
+      size_t dataStart = start.data;
+      for(size_t chunkPos = start.chunk; chunkPos > end.chunk; /* decrement is done inside the loop */) {
+
+        chunks[chunkPos - 1]->prefetch();
+        forEachDataReverse(chunkPos, dataStart, 0, modify, function, std::forward<Args>(args)...);
+
+        dataStart = chunks[--chunkPos]->getUsedSize(); // decrement of loop variable
+
+      }
+
+      forEachDataReverse(end.chunk, dataStart, end.data, modify, function, std::forward<Args>(args)...);
+    }
+
     /**
      * @brief Iterates over the data entries in the chunk.
      *
@@ -402,18 +458,24 @@ namespace codi {
      * @param chunkPos  The position of the chunk.
      * @param    start  The starting point inside the data of the chunk.
      * @param      end  The end point inside the data of the chunk.
+     * @param   modify  If the function modifies the data of the chunk.
      * @param function  The function called for each data entry.
      * @param     args  Additional arguments for the function.
      *
      * @tparam  Args  The data types for the arguments.
      */
     template<typename FunctionObject, typename ... Args>
-    CODI_INLINE void forEachDataReverse(const size_t& chunkPos, const size_t& start, const size_t& end, FunctionObject& function, Args&&... args) {
+    CODI_INLINE void forEachDataReverse(const size_t& chunkPos, const size_t& start, const size_t& end, const bool modify, FunctionObject& function, Args&&... args) {
       codiAssert(start >= end);
       codiAssert(chunkPos < chunks.size());
 
       PointerHandle<ChunkType> pHandle;
 
+      chunks[chunkPos]->load();
+      if(modify) {
+        chunks[chunkPos]->setModified();
+      }
+
       // we do not initialize dataPos with start - 1 since the type can be unsigned
       for(size_t dataPos = start; dataPos > end; /* decrement is done inside the loop */) {
         --dataPos; // decrement of loop variable
@@ -421,6 +483,8 @@ namespace codi {
         pHandle.setPointers(dataPos, chunks[chunkPos]);
         pHandle.call(function, std::forward<Args>(args)...);
       }
+
+      storeReadChunk(chunkPos);
     }
 
     /**
@@ -445,10 +509,14 @@ namespace codi {
 
       PointerHandle<ChunkType> pHandle;
 
+      chunks[chunkPos]->load();
+
       for(size_t dataPos = start; dataPos < end; dataPos += 1) {
         pHandle.setPointers(dataPos, chunks[chunkPos]);
         pHandle.call(function, std::forward<Args>(args)...);
       }
+
+      storeReadChunk(chunkPos);
     }
 
   public:
@@ -469,19 +537,27 @@ namespace codi {
      */
     template<typename FunctionObject, typename ... Args>
     CODI_INLINE void forEachReverse(const Position& start, const Position& end, FunctionObject& function, Args&&... args) {
-      codiAssert(start.chunk > end.chunk || (start.chunk == end.chunk && start.data >= end.data));
-      codiAssert(start.chunk < chunks.size());
-
-      size_t dataStart = start.data;
-      for(size_t chunkPos = start.chunk; chunkPos > end.chunk; /* decrement is done inside the loop */) {
-
-        forEachDataReverse(chunkPos, dataStart, 0, function, std::forward<Args>(args)...);
-
-        dataStart = chunks[--chunkPos]->getUsedSize(); // decrement of loop variable
-
-      }
+      forEachRangeReverse(start, end, false, function, std::forward<Args>(args)...);
+    }
 
-      forEachDataReverse(end.chunk, dataStart, end.data, function, std::forward<Args>(args)...);
+    /**
+     * @brief Iterates over all data entries in the given range, the function can modify the data.
+     *
+     * The same as forEachReverse but the chunks are marked as modified, such that chunks which keep their data
+     * somewhere else, e.g. in a scratch file, write the changes back.
+     *
+     * It has to hold start >= end.
+     *
+     * @param    start  The starting point of the range.
+     * @param      end  The end point of the range.
+     * @param function  The function called for each data entry.
+     * @param     args  Additional arguments for the function.
+     *
+     * @tparam  Args  The data types for the arguments.
+     */
+    template<typename FunctionObject, typename ... Args>
+    CODI_INLINE void modifyEachReverse(const Position& start, const Position& end, FunctionObject& function, Args&&... args) {
+      forEachRangeReverse(start, end, true, function, std::forward<Args>(args)...);
     }
 
     /**
@@ -506,6 +582,7 @@ namespace codi {
       size_t dataStart = start.data;
       for(size_t chunkPos = start.chunk; chunkPos < end.chunk; chunkPos += 1) {
 
+        chunks[chunkPos + 1]->prefetch();
         forEachDataForward(chunkPos, dataStart, chunks[chunkPos]->getUsedSize(), function, std::forward<Args>(args)...);
 
         dataStart = 0;
@@ -579,6 +656,8 @@ namespace codi {
       NestedPosition curInnerPos = start.inner;
       for(size_t curChunk = start.chunk; curChunk > end.chunk; --curChunk) {
 
+        chunks[curChunk]->load();
+        chunks[curChunk - 1]->prefetch();
         pHandle.setPointers(0, chunks[curChunk]);
 
         NestedPosition endInnerPos = positions[curChunk];
@@ -586,16 +665,81 @@ namespace codi {
 
         codiAssert(dataPos == 0); // after a full chunk is evaluated, the data position needs to be zero
 
+        storeReadChunk(curChunk);
+
         curInnerPos = endInnerPos;
 
         dataPos = chunks[curChunk - 1]->getUsedSize();
       }
 
       // Iterate over the reminder also covers the case if the start chunk and end chunk are the same
+      chunks[end.chunk]->load();
       pHandle.setPointers(0, chunks[end.chunk]);
       pHandle.callNestedReverse(nested, curInnerPos, end.inner, function, std::forward<Args>(args)..., dataPos, end.data);
 
       codiAssert(dataPos == end.data); // after the last chunk is evaluated, the data position needs to be at the end position
+
+      storeReadChunk(end.chunk);
+    }
+
+    /**
+     * @brief Reverse stack evaluation of the tape which can skip whole chunks.
+     *
+     * Before a full chunk is loaded, the skip function is called with the nested start and end positions of the
+     * chunk. The chunk is not evaluated if the skip function returns true. The nested vectors are not evaluated
+     * for the range of a skipped chunk either. The remainder in the end chunk is always evaluated.
+     *
+     * The skip function call is
+     * \code{.cpp}
+     * bool skip(const NestedPosition& start, const NestedPosition& end);
+     * \endcode
+     *
+     * All other arguments are the same as for evaluateReverse. It has to hold start >= end.
+     *
+     * @param    start  The start point for the stack interpretation.
+     * @param      end  The end point for the stack interpretation.
+     * @param     skip  The function which decides if a chunk is skipped.
+     * @param function  The function called for each valid range.
+     * @param     args  Pointers and ranges from other chunks vectors and additional arguments for the
+     *                  function.
+     *
+     * @tparam  Args  The data types for the arguments.
+     */
+    template<typename Skip, typename Function, typename ... Args>
+    CODI_INLINE void evaluateReverseSkip(const Position& start, const Position& end, const Skip& skip,
+                                         const Function& function, Args&&... args) {
+      PointerHandle<ChunkType> pHandle;
+
+      size_t dataPos = start.data;
+      NestedPosition curInnerPos = start.inner;
+      for(size_t curChunk = start.chunk; curChunk > end.chunk; --curChunk) {
+
+        NestedPosition endInnerPos = positions[curChunk];
+        if(!skip(curInnerPos, endInnerPos)) {
+          chunks[curChunk]->load();
+          chunks[curChunk - 1]->prefetch();
+          pHandle.setPointers(0, chunks[curChunk]);
+
+          pHandle.callNestedReverse(nested, curInnerPos, endInnerPos, function, std::forward<Args>(args)..., dataPos, 0);
+
+          codiAssert(dataPos == 0); // after a full chunk is evaluated, the data position needs to be zero
+
+          storeReadChunk(curChunk);
+        }
+
+        curInnerPos = endInnerPos;
+
+        dataPos = chunks[curChunk - 1]->getUsedSize();
+      }
+
+      // Iterate over the reminder also covers the case if the start chunk and end chunk are the same
+      chunks[end.chunk]->load();
+      pHandle.setPointers(0, chunks[end.chunk]);
+      pHandle.callNestedReverse(nested, curInnerPos, end.inner, function, std::forward<Args>(args)..., dataPos, end.data);
+
+      codiAssert(dataPos == end.data); // after the last chunk is evaluated, the data position needs to be at the end position
+
+      storeReadChunk(end.chunk);
     }
 
     /**
@@ -635,6 +779,8 @@ namespace codi {
       NestedPosition curInnerPos = start.inner;
       for(size_t curChunk = start.chunk; curChunk < end.chunk; ++curChunk) {
 
+        chunks[curChunk]->load();
+        chunks[curChunk + 1]->prefetch();
         pHandle.setPointers(0, chunks[curChunk]);
 
         NestedPosition endInnerPos = positions[curChunk + 1];
@@ -643,16 +789,44 @@ namespace codi {
         // After a full chunk is evaluated, the data position needs to be at the end of the chunk
         codiAssert(dataPos == chunks[curChunk]->getUsedSize());
 
+        storeReadChunk(curChunk);
+
         curInnerPos = endInnerPos;
 
         dataPos = 0;
       }
 
       // Iterate over the reminder also covers the case if the start chunk and end chunk are the same
+      chunks[end.chunk]->load();
       pHandle.setPointers(0, chunks[end.chunk]);
       pHandle.callNestedForward(nested, curInnerPos, end.inner, function, std::forward<Args>(args)..., dataPos, end.data);
 
       codiAssert(dataPos == end.data); // after the last chunk is evaluated, the data position needs to be at the end position
+
+      storeReadChunk(end.chunk);
     }
   };
+
+  /**
+   * @brief Chunk vectors which use a different allocator policy for the chunks.
+   *
+   * The nested alias can be used as the DataVector argument of the tape types, e.g.
+   * \code{.cpp}
+   *   JacobiTapeTypes<RTT, AllocatorChunkVector<HugePageChunkAllocator>::Type>
+   * \endcode
+   *
+   * @tparam Allocator  The allocator policy for the chunks, see ChunkAllocatorBase.
+   */
+  template<typename Allocator>
+  struct AllocatorChunkVector {
+
+    /**
+     * @brief The chunk vector with the rebound chunk type.
+     *
+     * @tparam    ChunkData  The data the chunk vector will store.
+     * @tparam NestedVector  A nested chunk vector used for position information.
+     */
+    template<typename ChunkData, typename NestedVector>
+    using Type = ChunkVector<typename ChunkAllocatorRebind<ChunkData, Allocator>::Type, NestedVector>;
+  };
 }
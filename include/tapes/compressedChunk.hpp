@@ -0,0 +1,568 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <vector>
+
+#include "../configure.h"
+#include "chunk.hpp"
+#include "chunkVector.hpp"
+#include "pointerHandle.hpp"
+
+#if CODI_EnableSwapChunkPrefetch
+  #include <future>
+
+  #include "swapChunk.hpp"
+#endif
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Lossless encoding of index and floating point arrays into byte streams.
+   *
+   * Indices are stored as the difference to the previous index. The difference is zig-zag encoded
+   * and written as a variable length integer with 7 bits per byte.
+   *
+   * Floating point values are stored with a one byte tag. The tag identifies the common values
+   * 0.0, 1.0, -1.0, 0.5, -0.5 and a repetition of the previous value. All other values are stored as the
+   * xor of their bit pattern with the bit pattern of the previous value. Only the significant low bytes of
+   * the xor are written, the number of bytes is part of the tag.
+   */
+  struct ChunkCodec {
+
+    /**
+     * @brief Append the indices to the byte stream.
+     *
+     * @param[in]   data  The indices.
+     * @param[in] length  The number of indices.
+     * @param[out]   out  The byte stream.
+     *
+     * @tparam Index  An integral type.
+     */
+    template<typename Index>
+    static void encodeIndices(const Index* data, const size_t length, std::vector<uint8_t>& out) {
+      uint64_t prev = 0;
+      for(size_t pos = 0; pos < length; ++pos) {
+        uint64_t cur = (uint64_t)data[pos];
+        int64_t diff = (int64_t)(cur - prev);
+        uint64_t value = ((uint64_t)diff << 1) ^ (uint64_t)(diff >> 63);
+
+        while(value >= 0x80) {
+          out.push_back((uint8_t)(value | 0x80));
+          value >>= 7;
+        }
+        out.push_back((uint8_t)value);
+
+        prev = cur;
+      }
+    }
+
+    /**
+     * @brief Read the indices from the byte stream.
+     *
+     * @param[out]  data  The indices.
+     * @param[in] length  The number of indices.
+     * @param[in]     in  The byte stream.
+     *
+     * @tparam Index  An integral type.
+     */
+    template<typename Index>
+    static void decodeIndices(Index* data, const size_t length, const uint8_t* in) {
+      uint64_t prev = 0;
+      for(size_t pos = 0; pos < length; ++pos) {
+        uint64_t value = 0;
+        int shift = 0;
+        uint8_t byte;
+        do {
+          byte = *in;
+          ++in;
+          value |= (uint64_t)(byte & 0x7f) << shift;
+          shift += 7;
+        } while(byte & 0x80);
+
+        uint64_t diff = (value >> 1) ^ (~(value & 1) + 1);
+        prev += diff;
+        data[pos] = (Index)prev;
+      }
+    }
+
+    /**
+     * @brief Append the floating point values to the byte stream.
+     *
+     * @param[in]   data  The values.
+     * @param[in] length  The number of values.
+     * @param[out]   out  The byte stream.
+     *
+     * @tparam Real  A floating point type with 4 or 8 bytes.
+     */
+    template<typename Real>
+    static void encodeReals(const Real* data, const size_t length, std::vector<uint8_t>& out) {
+      typedef typename BitType<Real>::Type Bits;
+
+      const Bits* constants = getConstants<Real>();
+
+      Bits prev = 0;
+      for(size_t pos = 0; pos < length; ++pos) {
+        Bits cur;
+        memcpy(&cur, &data[pos], sizeof(Bits));
+
+        uint8_t tag = 0;
+        while(tag < ConstantCount && constants[tag] != cur) {
+          tag += 1;
+        }
+
+        if(tag < ConstantCount) {
+          out.push_back(tag);
+        } else if(cur == prev) {
+          out.push_back((uint8_t)RepeatTag);
+        } else {
+          Bits value = cur ^ prev;
+          uint8_t bytes = 0;
+          for(Bits temp = value; 0 != temp; temp >>= 8) {
+            bytes += 1;
+          }
+
+          out.push_back((uint8_t)(RepeatTag + bytes));
+          for(uint8_t i = 0; i < bytes; ++i) {
+            out.push_back((uint8_t)(value >> (8 * i)));
+          }
+        }
+
+        prev = cur;
+      }
+    }
+
+    /**
+     * @brief Read the floating point values from the byte stream.
+     *
+     * @param[out]  data  The values.
+     * @param[in] length  The number of values.
+     * @param[in]     in  The byte stream.
+     *
+     * @tparam Real  A floating point type with 4 or 8 bytes.
+     */
+    template<typename Real>
+    static void decodeReals(Real* data, const size_t length, const uint8_t* in) {
+      typedef typename BitType<Real>::Type Bits;
+
+      const Bits* constants = getConstants<Real>();
+
+      Bits prev = 0;
+      for(size_t pos = 0; pos < length; ++pos) {
+        uint8_t tag = *in;
+        ++in;
+
+        Bits cur;
+        if(tag < ConstantCount) {
+          cur = constants[tag];
+        } else {
+          Bits value = 0;
+          for(uint8_t i = 0; i < tag - RepeatTag; ++i) {
+            value |= (Bits)(*in) << (8 * i);
+            ++in;
+          }
+          cur = prev ^ value;
+        }
+
+        memcpy(&data[pos], &cur, sizeof(Bits));
+        prev = cur;
+      }
+    }
+
+  private:
+
+    /**
+     * @brief The special tags of the float encoding.
+     *
+     * ConstantCount: The number of values which are encoded with the tag only.
+     * RepeatTag: Tag for the repetition of the previous value. Higher tags define the number of xor bytes.
+     */
+    enum Tags {
+      ConstantCount = 5,
+      RepeatTag = ConstantCount
+    };
+
+    /**
+     * @brief The unsigned integer type with the same size as the floating point type.
+     *
+     * @tparam Real  A floating point type with 4 or 8 bytes.
+     */
+    template<typename Real>
+    struct BitType {
+      static_assert(sizeof(Real) == 4 || sizeof(Real) == 8, "Only 4 and 8 byte floating point types are supported.");
+
+      /** @brief The unsigned integer type for the bit pattern. */
+      typedef typename std::conditional<sizeof(Real) == 8, uint64_t, uint32_t>::type Type;
+    };
+
+    /**
+     * @brief The bit patterns of the values which are encoded with the tag only.
+     *
+     * @return An array with ConstantCount entries.
+     *
+     * @tparam Real  A floating point type with 4 or 8 bytes.
+     */
+    template<typename Real>
+    static const typename BitType<Real>::Type* getConstants() {
+      typedef typename BitType<Real>::Type Bits;
+
+      struct Constants {
+        Bits values[ConstantCount];
+
+        Constants() {
+          const Real reals[ConstantCount] = {0.0, 1.0, -1.0, 0.5, -0.5};
+          memcpy(values, reals, sizeof(values));
+        }
+      };
+
+      static const Constants constants;
+
+      return constants.values;
+    }
+  };
+
+  /**
+   * @brief Chunk for Jacobi data which is compressed after it has been recorded.
+   *
+   * The chunk extends Chunk2 with a floating point type for the first array and an integral type for the
+   * second array. When the ChunkVector leaves the chunk and calls store, the used part of the arrays is
+   * encoded with the ChunkCodec and the arrays are deleted. The arrays are restored when load is called
+   * for the reverse or forward evaluation.
+   *
+   * The encoded data is kept until the chunk is changed, therefore a chunk that is loaded for an evaluation
+   * is not encoded again.
+   *
+   * If CODI_EnableSwapChunkPrefetch is set, prefetch decodes the data in the worker thread of the SwapChunkStorage.
+   * The following load waits until the data is available.
+   *
+   * @tparam      Real  The floating point type of the Jacobies.
+   * @tparam     Index  The integral type of the indices.
+   * @tparam Allocator  The allocator policy for the data arrays.
+   */
+  template<typename Real, typename Index, typename Allocator = PoolChunkAllocator>
+  struct CompressedChunk2 final : public Chunk2<Real, Index, Allocator> {
+
+    /** @brief The memory chunk which holds the data. */
+    typedef Chunk2<Real, Index, Allocator> BaseChunk;
+
+    /** @brief The data is decoded and released during the evaluation. */
+    static const bool ConcurrentRead = false;
+
+    std::vector<uint8_t> encoded1; /**< The encoded first data array. */
+    std::vector<uint8_t> encoded2; /**< The encoded second data array. */
+
+    bool dirty; /**< If the data was changed since it was encoded. */
+
+#if CODI_EnableSwapChunkPrefetch
+    mutable std::future<void> prefetchResult; /**< The result of the background decoding of the data. */
+#endif
+
+    /**
+     * @brief Creates the data of the chunk.
+     *
+     * @param size The size of the data in the chunk.
+     */
+    CompressedChunk2(const size_t& size) :
+      BaseChunk(size),
+      encoded1(),
+      encoded2(),
+      dirty(true)
+#if CODI_EnableSwapChunkPrefetch
+      , prefetchResult()
+#endif
+    {}
+
+    /**
+     * @brief Waits for the background decoding before the data is released.
+     */
+    ~CompressedChunk2() {
+#if CODI_EnableSwapChunkPrefetch
+      if(prefetchResult.valid()) {
+        prefetchResult.wait(); // errors can not be reported in the destructor
+      }
+#endif
+    }
+
+    /**
+     * @brief Check if the arrays of the chunk are allocated.
+     *
+     * @return True if the data can be accessed directly.
+     */
+    CODI_INLINE bool isLoaded() const {
+      return NULL != this->data1;
+    }
+
+    /**
+     * @brief The number of bytes of the encoded data.
+     *
+     * @return Zero if the data has not been encoded.
+     */
+    CODI_INLINE size_t getCompressedSize() const {
+      return encoded1.size() + encoded2.size();
+    }
+
+    /**
+     * @brief Write all the data of the chunk to the io handle.
+     *
+     * If the chunk is not loaded, the data is decoded into a temporary chunk.
+     *
+     * @param[in,out] handle  The handle for the io operations.
+     */
+    void writeData(CoDiIoHandle& handle) const {
+      waitForPrefetch();
+
+      if(isLoaded()) {
+        BaseChunk::writeData(handle);
+      } else {
+        BaseChunk temp(this->size);
+        decode(temp);
+        temp.BaseChunk::writeData(handle);
+      }
+    }
+
+    /**
+     * @brief Read the data for the chunk from the io handle.
+     *
+     * The method ensures that the data is allocated. The encoded data is no longer valid.
+     *
+     * @param[in,out] handle  The handle for the io operations.
+     */
+    void readData(CoDiIoHandle& handle) {
+      waitForPrefetch();
+
+      BaseChunk::readData(handle);
+
+      clearEncoded();
+    }
+
+    /**
+     * @brief Deletes the data and the encoded data of the chunk.
+     */
+    void deleteData() {
+      waitForPrefetch();
+
+      BaseChunk::deleteData();
+
+      clearEncoded();
+    }
+
+    /**
+     * @brief Set the size of the arrays.
+     * @param size  The new size of the arrays.
+     */
+    void resize(const size_t &size) {
+      this->~CompressedChunk2();
+      new (this) CompressedChunk2(size);
+    }
+
+    /**
+     * @brief Fully reset the data in this chunk.
+     *
+     * The encoded data is no longer valid.
+     */
+    CODI_INLINE void reset() {
+      waitForPrefetch();
+
+      BaseChunk::reset();
+
+      clearEncoded();
+    }
+
+    /**
+     * @brief Set the number of used items in this chunk.
+     *
+     * The data is marked as changed.
+     *
+     * @param usage   The number of used items.
+     */
+    CODI_INLINE void setUsedSize(const size_t& usage) {
+      BaseChunk::setUsedSize(usage);
+
+      dirty = true;
+    }
+
+    /**
+     * @brief Mark the data of the chunk as changed.
+     */
+    CODI_INLINE void setModified() {
+      dirty = true;
+    }
+
+    /**
+     * @brief Encode the data if it was changed and delete the arrays.
+     */
+    void store() {
+      waitForPrefetch();
+
+      if(isLoaded()) {
+        if(dirty) {
+          encoded1.clear();
+          encoded2.clear();
+          ChunkCodec::encodeReals(this->data1, this->usedSize, encoded1);
+          ChunkCodec::encodeIndices(this->data2, this->usedSize, encoded2);
+          std::vector<uint8_t>(encoded1).swap(encoded1);
+          std::vector<uint8_t>(encoded2).swap(encoded2);
+
+          dirty = false;
+        }
+
+        BaseChunk::deleteData();
+      }
+    }
+
+    /**
+     * @brief Allocate the arrays and decode the data.
+     */
+    void load() {
+      waitForPrefetch();
+
+      if(!isLoaded()) {
+        BaseChunk::allocateData();
+
+        decode(*this);
+      }
+    }
+
+    /**
+     * @brief Start the decoding of the data in the worker thread of the SwapChunkStorage.
+     *
+     * Without CODI_EnableSwapChunkPrefetch the method does nothing.
+     */
+    void prefetch() {
+#if CODI_EnableSwapChunkPrefetch
+      if(!isLoaded()) {
+        BaseChunk::allocateData();
+
+        CompressedChunk2* chunk = this;
+        prefetchResult = SwapChunkStorage::getGlobal().runAsync([chunk]() {
+          chunk->decode(*chunk);
+        });
+      }
+#endif
+    }
+
+    /**
+     * @brief Wait until the background decoding of the data is finished.
+     *
+     * Errors of the decoding are reported here. Without CODI_EnableSwapChunkPrefetch the method does nothing.
+     */
+    CODI_INLINE void waitForPrefetch() const {
+#if CODI_EnableSwapChunkPrefetch
+      if(prefetchResult.valid()) {
+        prefetchResult.get();
+      }
+#endif
+    }
+
+  private:
+
+    /**
+     * @brief Decode the used part of the data into the arrays of the chunk.
+     *
+     * @param[in,out] chunk  A chunk with allocated arrays.
+     */
+    void decode(BaseChunk& chunk) const {
+      if(0 != this->usedSize) {
+        codiAssert(!dirty);
+
+        ChunkCodec::decodeReals(chunk.data1, this->usedSize, encoded1.data());
+        ChunkCodec::decodeIndices(chunk.data2, this->usedSize, encoded2.data());
+      }
+    }
+
+    /**
+     * @brief Release the encoded data and mark the data as changed.
+     */
+    void clearEncoded() {
+      std::vector<uint8_t>().swap(encoded1);
+      std::vector<uint8_t>().swap(encoded2);
+
+      dirty = true;
+    }
+  };
+
+  /**
+   * @brief Specialization for PointerHandle with a CompressedChunk2 type.
+   *
+   * The pointers are set by the handle of the memory chunk.
+   *
+   * @tparam      Real  The floating point type of the Jacobies.
+   * @tparam     Index  The integral type of the indices.
+   * @tparam Allocator  The allocator policy for the data arrays.
+   */
+  template<typename Real, typename Index, typename Allocator>
+  struct PointerHandle<CompressedChunk2<Real, Index, Allocator> > : public PointerHandle<Chunk2<Real, Index, Allocator> > {};
+
+  /**
+   * @brief Selects the compressed chunk for the chunks that can be encoded.
+   *
+   * Chunk2 types with a floating point type and an integral type are replaced by CompressedChunk2.
+   * All other chunks are not changed.
+   *
+   * @tparam Chunk  The memory chunk.
+   */
+  template<typename Chunk>
+  struct CompressedChunkSelect {
+    /** @brief The chunk type for the vector. */
+    typedef Chunk Type;
+  };
+
+  /**
+   * @brief Specialization for Chunk2 types.
+   *
+   * @tparam     Data1  The first data type for the chunk.
+   * @tparam     Data2  The second data type for the chunk.
+   * @tparam Allocator  The allocator policy for the data arrays.
+   */
+  template<typename Data1, typename Data2, typename Allocator>
+  struct CompressedChunkSelect<Chunk2<Data1, Data2, Allocator> > {
+    /** @brief The chunk type for the vector. */
+    typedef typename std::conditional<std::is_floating_point<Data1>::value && std::is_integral<Data2>::value,
+                                      CompressedChunk2<Data1, Data2, Allocator>,
+                                      Chunk2<Data1, Data2, Allocator> >::type Type;
+  };
+
+  /**
+   * @brief A chunk vector which compresses the Jacobi data of the chunks.
+   *
+   * The vector can be used as the DataVector argument of the JacobiTapeTypes. Only the Jacobi chunks are
+   * compressed, see CompressedChunkSelect.
+   *
+   * @tparam    ChunkData  The memory chunk for the data.
+   * @tparam NestedVector  A nested chunk vector used for position information.
+   */
+  template<typename ChunkData, typename NestedVector>
+  using CompressedChunkVector = ChunkVector<typename CompressedChunkSelect<ChunkData>::Type, NestedVector>;
+}
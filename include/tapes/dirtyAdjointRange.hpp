@@ -0,0 +1,257 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "../configure.h"
+#include "../macros.h"
+#include "zeroPageArray.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Tracks the part of an adjoint vector that might be nonzero, such that a clear of the vector only resets that part.
+   *
+   * Two kinds of entries are tracked:
+   *  - single indices which are accessed by the user, e.g. through the gradient method of the tape and
+   *  - tape ranges which have been evaluated with the adjoint vector.
+   *
+   * The single indices are merged into the range [low, high]. The tape ranges are stored and only inspected when
+   * the vector is cleared. Then all adjoint values which are accessed by the evaluation of the range are reset
+   * to zero. The inspection is done by the method forEachAdjointIndex of the tape. If the tape data of a stored
+   * range is changed, e.g. by a reset of the tape, the ranges need to be merged into [low, high] with
+   * mergeRanges beforehand.
+   *
+   * An evaluation from the zero position of the tape or a range with external functions marks the whole vector.
+   *
+   * @tparam    Index  The type for the indices of the adjoint vector.
+   * @tparam Position  The position type of the tape.
+   */
+  template<typename Index, typename Position>
+  struct DirtyAdjointRange {
+    private:
+
+      /** @brief The maximum number of stored tape ranges. More ranges are merged into [low, high]. */
+      static const size_t MaxRanges = 64;
+
+      Index low; /**< The smallest index that might be nonzero. */
+      Index high; /**< The largest index that might be nonzero. */
+
+      std::vector<std::pair<Position, Position> > ranges; /**< The evaluated tape ranges. */
+
+    public:
+
+      /**
+       * @brief Creates a range for a zero adjoint vector.
+       */
+      DirtyAdjointRange() :
+        low(std::numeric_limits<Index>::max()),
+        high(0),
+        ranges() {}
+
+      /**
+       * @brief Mark a single index.
+       *
+       * @param[in] index  The index of the accessed adjoint value.
+       */
+      CODI_INLINE void addIndex(const Index& index) {
+        if(index < low) {
+          low = index;
+        }
+        if(high < index) {
+          high = index;
+        }
+      }
+
+      /**
+       * @brief Mark the whole adjoint vector.
+       */
+      void addAll() {
+        low = 0;
+        high = std::numeric_limits<Index>::max();
+        ranges.clear();
+      }
+
+      /**
+       * @brief Mark all indices which are accessed by the evaluation of the tape range.
+       *
+       * It has to hold start >= end.
+       *
+       * @param[in,out] tape  The tape which is evaluated.
+       * @param[in]    start  The start of the evaluated range.
+       * @param[in]      end  The end of the evaluated range.
+       *
+       * @tparam Tape  The tape needs to provide getZeroPosition and forEachAdjointIndex.
+       */
+      template<typename Tape>
+      void addRange(Tape& tape, const Position& start, const Position& end) {
+        Position zeroPos = tape.getZeroPosition();
+        if(zeroPos == end) {
+          // the whole tape is usually larger than the adjoint vector
+          addAll();
+        } else if(isAll()) {
+          // nothing to do
+        } else {
+          for(std::pair<Position, Position>& range : ranges) {
+            if(range.first == start && range.second == end) {
+              return;
+            }
+          }
+
+          if(ranges.size() >= MaxRanges) {
+            mergeRanges(tape);
+          }
+          ranges.push_back(std::make_pair(start, end));
+        }
+      }
+
+      /**
+       * @brief Add the indices of all stored tape ranges to [low, high] and remove the ranges.
+       *
+       * Needs to be called before the data of the tape is changed.
+       *
+       * @param[in,out] tape  The tape of the ranges.
+       *
+       * @tparam Tape  The tape needs to provide forEachAdjointIndex.
+       */
+      template<typename Tape>
+      void mergeRanges(Tape& tape) {
+        auto addFunc = [this] (const Index& index) {
+          addIndex(index);
+        };
+
+        for(std::pair<Position, Position>& range : ranges) {
+          if(!tape.forEachAdjointIndex(range.first, range.second, addFunc)) {
+            addAll();
+            break;
+          }
+        }
+        ranges.clear();
+      }
+
+      /**
+       * @brief Reset all marked entries of the adjoint vector to zero and remove all marks.
+       *
+       * @param[in,out]       tape  The tape of the ranges.
+       * @param[in,out]   adjoints  The adjoint vector.
+       * @param[in]           size  The size of the adjoint vector.
+       * @param[in]   isZeroPages  If the adjoint vector was allocated by ZeroPageArray. The pages of large
+       *                           ranges are released in this case.
+       *
+       * @tparam        Tape  The tape needs to provide forEachAdjointIndex.
+       * @tparam AdjointData  The type of the entries in the adjoint vector.
+       */
+      template<typename Tape, typename AdjointData>
+      void clear(Tape& tape, AdjointData* adjoints, const size_t size, const bool isZeroPages = false) {
+        auto clearFunc = [adjoints, size] (const Index& index) {
+          if((size_t)index < size) {
+            adjoints[index] = AdjointData();
+          }
+        };
+
+        for(std::pair<Position, Position>& range : ranges) {
+          if(!tape.forEachAdjointIndex(range.first, range.second, clearFunc)) {
+            addAll();
+            break;
+          }
+        }
+        ranges.clear();
+
+        if(low <= high && 0 != size) {
+          size_t end = std::min((size_t)high, size - 1);
+          if(isZeroPages) {
+            ZeroPageArray<AdjointData>::zero(adjoints, (size_t)low, end + 1);
+          } else {
+            for(size_t i = (size_t)low; i <= end; ++i) {
+              adjoints[i] = AdjointData();
+            }
+          }
+        }
+
+        low = std::numeric_limits<Index>::max();
+        high = 0;
+      }
+
+      /**
+       * @brief Remove all marks without a reset of the adjoint vector.
+       *
+       * Used if the adjoint vector is deleted.
+       */
+      void reset() {
+        low = std::numeric_limits<Index>::max();
+        high = 0;
+        ranges.clear();
+      }
+
+      /**
+       * @brief Get the range of the marked single indices.
+       *
+       * All adjoint values outside of [lowIndex, highIndex] are zero if no tape ranges are stored.
+       * The range is empty if lowIndex > highIndex.
+       *
+       * @param[out]  lowIndex  The smallest marked index.
+       * @param[out] highIndex  The largest marked index.
+       *
+       * @return false if tape ranges are stored. The nonzero adjoint values are not known in this case.
+       */
+      bool getIndexRange(Index& lowIndex, Index& highIndex) const {
+        lowIndex = low;
+        highIndex = high;
+
+        return ranges.empty();
+      }
+
+      /**
+       * @brief Check if the whole adjoint vector is marked.
+       *
+       * @return true if a clear resets the whole vector.
+       */
+      bool isAll() const {
+        return 0 == low && std::numeric_limits<Index>::max() == high;
+      }
+
+      /**
+       * @brief Swap the contents with the other range.
+       *
+       * @param[in,out] other  The other range.
+       */
+      void swap(DirtyAdjointRange& other) {
+        std::swap(low, other.low);
+        std::swap(high, other.high);
+        ranges.swap(other.ranges);
+      }
+  };
+}
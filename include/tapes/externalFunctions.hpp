@@ -83,6 +83,9 @@ namespace codi {
     /** @brief The data for the function. */
     void* data;
 
+    /** @brief If the function can be called by several threads at the same time. */
+    bool reentrant;
+
   public:
     /**
      * @brief Needed to construct arrays.
@@ -98,7 +101,29 @@ namespace codi {
     ExternalFunction(CallFunction func, void* data, DeleteFunction deleteCheckpoint) :
       func(func),
       deleteCheckpoint(deleteCheckpoint),
-      data(data){}
+      data(data),
+      reentrant(false){}
+
+    /**
+     * @brief Declare if the function can be called by several threads at the same time.
+     *
+     * Reentrant functions must not modify their data during the evaluation. They are required for
+     * the ConcurrentEvaluationHelper.
+     *
+     * @param[in] value  True if the function is reentrant.
+     */
+    void setReentrant(const bool value) {
+      reentrant = value;
+    }
+
+    /**
+     * @brief Check if the function can be called by several threads at the same time.
+     *
+     * @return True if the function is reentrant.
+     */
+    bool isReentrant() const {
+      return reentrant;
+    }
 
     /**
      * @brief Delete the data provided by the user.
@@ -0,0 +1,175 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../configure.h"
+#include "../macros.h"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief The mapping of a compaction of the index space, which moves the live indices into a dense range.
+   *
+   * The live indices keep their order and are numbered consecutively after the reserved indices of the index
+   * handler. All other indices are no longer valid and are mapped to the passive index zero. The indices in the
+   * new range are never larger than the old ones, therefore the vectors which are addressed by the indices
+   * can be compacted in place.
+   *
+   * After the compaction all active variables need to be updated with apply.
+   *
+   * @tparam Index  The type for the indices.
+   */
+  template<typename Index>
+  struct IndexCompaction {
+
+    std::vector<Index> newIndices; /**< The new index for each old index */
+
+  private:
+
+    Index nextIndex;
+    size_t liveIndices;
+
+  public:
+
+    /**
+     * @brief Creates an empty compaction.
+     */
+    IndexCompaction() :
+      newIndices(),
+      nextIndex(0),
+      liveIndices(0) {}
+
+    /**
+     * @brief Remove all data and start the collection of the live indices.
+     *
+     * @param[in]    maxIndex  The size of the old index range.
+     * @param[in] reservedEnd  The first index after the reserved indices. These indices keep their numbers, the zero index is always reserved.
+     */
+    void begin(const Index& maxIndex, const Index& reservedEnd) {
+      newIndices.assign((size_t)maxIndex, 0);
+      for(size_t i = 0; i < (size_t)reservedEnd && i < newIndices.size(); ++i) {
+        newIndices[i] = (Index)i;
+      }
+
+      nextIndex = reservedEnd;
+      liveIndices = 0;
+    }
+
+    /**
+     * @brief Add the next live index. The indices need to be added in increasing order.
+     *
+     * @param[in] index  The live index.
+     *
+     * @return The new number of the index.
+     */
+    CODI_INLINE Index addIndex(const Index& index) {
+      codiAssert((size_t)index < newIndices.size());
+      codiAssert(nextIndex <= index);
+
+      newIndices[index] = nextIndex;
+      nextIndex += 1;
+      liveIndices += 1;
+
+      return newIndices[index];
+    }
+
+    /**
+     * @brief Get the number of live indices.
+     *
+     * @return The number of indices which have been moved into the dense range.
+     */
+    size_t getIndexCount() const {
+      return liveIndices;
+    }
+
+    /**
+     * @brief Get the end of the new index range.
+     *
+     * @return The first index after the compacted range.
+     */
+    Index getIndexEnd() const {
+      return nextIndex;
+    }
+
+    /**
+     * @brief Get the new number of an index.
+     *
+     * @param[in] index  The old index.
+     * @return The new index or zero if the index is not live.
+     */
+    CODI_INLINE Index getNewIndex(const Index& index) const {
+      if((size_t)index < newIndices.size()) {
+        return newIndices[index];
+      } else {
+        return 0;
+      }
+    }
+
+    /**
+     * @brief Replace an index with its new number.
+     *
+     * @param[in,out] index  The index of an active variable.
+     */
+    CODI_INLINE void apply(Index& index) const {
+      index = getNewIndex(index);
+    }
+
+    /**
+     * @brief Move the entries of a vector which is addressed by the indices to the new indices.
+     *
+     * The entries of the reserved and the live indices are moved to the front of the vector. Entries at or
+     * beyond size are treated as default values. The entries after the new index range are not changed and can
+     * be removed by a resize to getIndexEnd().
+     *
+     * @param[in,out] data  The vector which is addressed by the indices, e.g. the adjoint vector.
+     * @param[in]     size  The size of the vector.
+     *
+     * @tparam Data  The type of the entries.
+     */
+    template<typename Data>
+    void compact(Data* data, const size_t& size) const {
+      for(size_t i = 0; i < newIndices.size(); ++i) {
+        size_t newIndex = (size_t)newIndices[i];
+        if(0 != newIndex && newIndex != i && newIndex < size) {
+          if(i < size) {
+            data[newIndex] = data[i];
+          } else {
+            data[newIndex] = Data();
+          }
+        }
+      }
+    }
+  };
+}
@@ -0,0 +1,177 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "../configure.h"
+#include "../macros.h"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief A renumbering of the indices in a recorded tape range for a better locality of the adjoint vector.
+   *
+   * The indices are added in the order in which the reverse evaluation accesses them. The k-th added index
+   * gets the k-th smallest index of the range as its new index. The renumbering is therefore a permutation of
+   * the indices in the range and all other indices keep their number. The new numbers are in the
+   * same range as the old ones such that the index handler and the size of the adjoint vector stay valid.
+   *
+   * After the renumbering all active variables which have an index of the range need to be updated with
+   * apply, e.g. the registered inputs and outputs.
+   *
+   * @tparam Index  The type for the indices.
+   */
+  template<typename Index>
+  struct IndexRenumbering {
+
+    std::vector<Index> newIndices; /**< The new index for each old index */
+
+  private:
+
+    std::vector<Index> order;
+    std::vector<Index> slots;
+
+  public:
+
+    /**
+     * @brief Creates an empty renumbering.
+     */
+    IndexRenumbering() :
+      newIndices(),
+      order(),
+      slots() {}
+
+    /**
+     * @brief Remove all data and start the collection of the indices of a new range.
+     *
+     * @param[in] maxIndex  The largest index used in the range.
+     */
+    void begin(const Index& maxIndex) {
+      newIndices.assign((size_t)maxIndex + 1, 0);
+      order.clear();
+      slots.clear();
+    }
+
+    /**
+     * @brief Add an index in the order of the reverse evaluation.
+     *
+     * The zero index and indices that have already been added are ignored.
+     *
+     * @param[in] index  The accessed index.
+     */
+    CODI_INLINE void addIndex(const Index& index) {
+      codiAssert((size_t)index < newIndices.size());
+
+      if(0 != index && 0 == newIndices[index]) {
+        newIndices[index] = 1; // mark the index as added
+        order.push_back(index);
+      }
+    }
+
+    /**
+     * @brief Compute the new indices from the order of the added indices.
+     */
+    void finalize() {
+      slots = order;
+      std::sort(slots.begin(), slots.end());
+
+      for(size_t i = 0; i < newIndices.size(); ++i) {
+        newIndices[i] = (Index)i;
+      }
+
+      for(size_t k = 0; k < order.size(); ++k) {
+        newIndices[order[k]] = slots[k];
+      }
+    }
+
+    /**
+     * @brief Get the number of renumbered indices.
+     *
+     * @return The number of different indices in the range.
+     */
+    size_t getIndexCount() const {
+      return order.size();
+    }
+
+    /**
+     * @brief Get the new number of an index.
+     *
+     * @param[in] index  The old index.
+     * @return The new index.
+     */
+    CODI_INLINE Index getNewIndex(const Index& index) const {
+      if((size_t)index < newIndices.size()) {
+        return newIndices[index];
+      } else {
+        return index;
+      }
+    }
+
+    /**
+     * @brief Replace an index with its new number.
+     *
+     * @param[in,out] index  The index of an active variable or of the tape data.
+     */
+    CODI_INLINE void apply(Index& index) const {
+      index = getNewIndex(index);
+    }
+
+    /**
+     * @brief Move the entries of a vector which is addressed by the indices to the new indices.
+     *
+     * Entries at or beyond size are treated as default values.
+     *
+     * @param[in,out] data  The vector which is addressed by the indices, e.g. the adjoint vector.
+     * @param[in]     size  The size of the vector.
+     *
+     * @tparam Data  The type of the entries.
+     */
+    template<typename Data>
+    void permute(Data* data, const size_t& size) const {
+      std::vector<Data> values(order.size());
+      for(size_t k = 0; k < order.size(); ++k) {
+        if((size_t)order[k] < size) {
+          values[k] = data[order[k]];
+        }
+      }
+
+      for(size_t k = 0; k < order.size(); ++k) {
+        if((size_t)slots[k] < size) {
+          data[slots[k]] = values[k];
+        }
+      }
+    }
+  };
+}
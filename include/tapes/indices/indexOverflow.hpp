@@ -0,0 +1,63 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#pragma once
+
+#include <limits>
+
+#include "../../configure.h"
+#include "../../exceptions.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Checks that the next indices of an index handler can be represented by the index type.
+   *
+   * The handlers use the indices up to last + count - 1 and the adjoint and primal vectors are sized with the
+   * largest index plus one. Therefore last + count needs to be smaller than the maximum of the index type.
+   *
+   * The check is only performed if CheckIndexOverflow is set.
+   *
+   * @param[in]  last  The largest index or the first index of the new block.
+   * @param[in] count  The number of indices that are added after last.
+   *
+   * @tparam Index  The type for the handled indices.
+   */
+  template<typename Index>
+  CODI_INLINE void checkIndexOverflow(const Index& last, const size_t count) {
+    if(CheckIndexOverflow) {
+      if((size_t)(std::numeric_limits<Index>::max() - last) <= count) {
+        CODI_EXCEPTION("Index overflow: The index type with %d bits can not represent more than %llu indices. Use a"
+                       " type with a wider index e.g. RealReverse64.",
+                       (int)(sizeof(Index) * 8), (unsigned long long)std::numeric_limits<Index>::max());
+      }
+    }
+  }
+}
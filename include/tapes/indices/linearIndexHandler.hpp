@@ -33,6 +33,7 @@
 #include "../../configure.h"
 #include "../../macros.h"
 #include "../../tools/tapeValues.hpp"
+#include "indexOverflow.hpp"
 
 /**
  * @brief Global namespace for CoDiPack - Code Differentiation Package
@@ -92,7 +93,10 @@ namespace codi {
        */
       LinearIndexHandler(Index zeroState) :
         zeroState(zeroState),
-        count(zeroState) {}
+        count(zeroState) {
+        // The check depends on Index such that it is only evaluated for handlers that are used.
+        static_assert(!ThreadLocalTape || sizeof(Index) == 0, "The indices of thread local tapes with a linear index handler overlap. Use an index tape, e.g. RealReverseIndex.");
+      }
 
       /**
        * @brief Swap the contents of this linear index handler with the contents of the other
@@ -121,11 +125,14 @@ namespace codi {
       /**
        * @brief Generate a new index.
        *
-       * The indices are linear increasing.
+       * The indices are linear increasing. An exception is raised if the index type overflows and
+       * CheckIndexOverflow is set.
        *
        * @return The new index that can be used.
        */
       CODI_INLINE Index createIndex() {
+        checkIndexOverflow(count, 1);
+
         return ++count;
       }
 
@@ -32,6 +32,8 @@
 
 #include "../../configure.h"
 #include "../../tools/tapeValues.hpp"
+#include "indexOverflow.hpp"
+#include "sharedIndexRange.hpp"
 
 /**
  * @brief Global namespace for CoDiPack - Code Differentiation Package
@@ -150,6 +152,10 @@ namespace codi {
 #if CODI_IndexHandle
           handleIndexFree(index);
 #endif
+          if(ThreadLocalTape && globalMaximumIndex <= index) {
+            globalMaximumIndex = index + 1; // the index was created by the handler of another thread
+          }
+
           if(usedIndicesPos == usedIndices.size()) {
             increaseIndicesSize(usedIndices);
           }
@@ -258,6 +264,25 @@ namespace codi {
         usedIndicesPos = 0;
       }
 
+      /**
+       * @brief Replace the stored indices with their new numbers.
+       *
+       * The renumbering has to be a permutation of the indices, see IndexRenumbering.
+       *
+       * @param[in] renumbering  The new numbers of the indices.
+       *
+       * @tparam Renumbering  The type of the renumbering, e.g. IndexRenumbering.
+       */
+      template<typename Renumbering>
+      void renumberIndices(const Renumbering& renumbering) {
+        for(size_t pos = 0; pos < usedIndicesPos; ++pos) {
+          renumbering.apply(usedIndices[pos]);
+        }
+        for(size_t pos = 0; pos < unusedIndicesPos; ++pos) {
+          renumbering.apply(unusedIndices[pos]);
+        }
+      }
+
       /**
        * @brief Get the maximum global
        *
@@ -294,13 +319,45 @@ namespace codi {
         return unusedIndices.capacity() + usedIndices.capacity();
       }
 
+      /**
+       * @brief Get the number of free indices which are smaller than the largest index in use.
+       *
+       * The value is zero if the live indices are dense.
+       *
+       * @return The number of gaps between the live indices.
+       */
+      size_t getNumberIndexGaps() const {
+        std::vector<bool> isFree(globalMaximumIndex, false);
+        for(size_t pos = 0; pos < usedIndicesPos; ++pos) {
+          if((size_t)usedIndices[pos] < isFree.size()) { // indices from other threads can be larger
+            isFree[usedIndices[pos]] = true;
+          }
+        }
+        for(size_t pos = 0; pos < unusedIndicesPos; ++pos) {
+          isFree[unusedIndices[pos]] = true;
+        }
+
+        size_t gaps = 0;
+        size_t freeIndices = 0;
+        for(size_t index = 1; index < isFree.size(); ++index) {
+          if(isFree[index]) {
+            freeIndices += 1;
+          } else {
+            gaps = freeIndices;
+          }
+        }
+
+        return gaps;
+      }
+
       /**
        * @brief Add statistics about the used indices.
        *
        * Adds the
        *   maximum number of live indices,
        *   the current number of lives indices,
-       *   the indices that are stored and
+       *   the indices that are stored,
+       *   the free indices below the largest live index and
        *   the memory for the allocated indices.
        *
        * @param[in,out] values  The values where the information is added to.
@@ -309,6 +366,7 @@ namespace codi {
         size_t maximumGlobalIndex     = (size_t)this->getMaximumGlobalIndex();
         size_t storedIndices          = (size_t)this->getNumberStoredIndices();
         size_t currentLiveIndices     = (size_t)this->getCurrentIndex() - this->getNumberStoredIndices();
+        size_t indexGaps              = this->getNumberIndexGaps();
 
         double memoryStoredIndices    = (double)storedIndices*(double)(sizeof(Index)) * BYTE_TO_MB;
         double memoryAllocatedIndices = (double)this->getNumberAllocatedIndices()*(double)(sizeof(Index)) * BYTE_TO_MB;
@@ -317,6 +375,7 @@ namespace codi {
         values.addData("Max. live indices", maximumGlobalIndex);
         values.addData("Cur. live indices", currentLiveIndices);
         values.addData("Indices stored", storedIndices);
+        values.addData("Index gaps", indexGaps);
         values.addData("Memory used", memoryStoredIndices, true, false);
         values.addData("Memory allocated", memoryAllocatedIndices, false, true);
       }
@@ -330,6 +389,11 @@ namespace codi {
 
         codiAssert(unusedIndices.size() >= indexSizeIncrement);
 
+        if(ThreadLocalTape) {
+          globalMaximumIndex = SharedIndexRange<Index>::claimBlock(globalMaximumIndex, indexSizeIncrement);
+        }
+        checkIndexOverflow(globalMaximumIndex, indexSizeIncrement);
+
         for(size_t pos = 0; pos < indexSizeIncrement; ++pos) {
           unusedIndices[unusedIndicesPos + pos] = globalMaximumIndex + (Index)pos;
         }
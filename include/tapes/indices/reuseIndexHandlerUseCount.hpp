@@ -28,10 +28,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
 
 #include "../../configure.h"
+#include "../../exceptions.hpp"
 #include "../../tools/tapeValues.hpp"
+#include "indexOverflow.hpp"
+#include "sharedIndexRange.hpp"
 
 /**
  * @brief Global namespace for CoDiPack - Code Differentiation Package
@@ -61,8 +65,10 @@ namespace codi {
 
       /**
        * @brief If it is required to write an assign statement after the index is copied.
+       *
+       * Thread local tapes can not share an index between variables, since the use count is only known to one thread.
        */
-      const static bool AssignNeedsStatement = OptDisableAssignOptimization;
+      const static bool AssignNeedsStatement = OptDisableAssignOptimization || ThreadLocalTape;
 
       /**
        * @brief Indicates if the index handler privides linear increasing indices.
@@ -73,6 +79,9 @@ namespace codi {
 
     private:
 
+      /** @brief The number of indices which are reserved and not used by the handler. */
+      Index reservedIndices;
+
       /** @brief The maximum index that was used over the whole process */
       Index globalMaximumIndex;
 
@@ -128,6 +137,7 @@ namespace codi {
        * @param[in] reserveIndices  The number of indices that are reserved and not used by the manager.
        */
       ReuseIndexHandlerUseCount(const Index reserveIndices) :
+        reservedIndices(reserveIndices),
         globalMaximumIndex(reserveIndices),
         usedIndices(),
         usedIndicesPos(0),
@@ -156,6 +166,10 @@ namespace codi {
        */
       CODI_INLINE void freeIndex(Index& index) {
         if(valid && 0 != index) { // do not free the zero index
+          if(ThreadLocalTape) {
+            adoptIndex(index);
+          }
+
           indexUse[index] -= 1;
 
           if(indexUse[index] == 0) { // only free the index if it not used any longer
@@ -236,6 +250,8 @@ namespace codi {
       CODI_INLINE void assignIndex(Index& index) {
         if(0 == index) {
           index = this->createIndex();
+        } else if(ThreadLocalTape) {
+          adoptIndex(index);
         } else if(indexUse[index] > 1) {
           indexUse[index] -= 1;
 
@@ -264,7 +280,7 @@ namespace codi {
        * @param[in]    rhs  The index of the rhs.
        */
       CODI_INLINE void copyIndex(Index& lhs, const Index& rhs) {
-        if(!OptDisableAssignOptimization) {
+        if(!AssignNeedsStatement) {
           // skip the logic if the indices are the same.
           // This also prevents the bug, that if &lhs == &rhs the left hand side will always be deactivated.
           if(lhs != rhs) {
@@ -298,6 +314,69 @@ namespace codi {
         usedIndicesPos = 0;
       }
 
+      /**
+       * @brief Replace the stored indices with their new numbers.
+       *
+       * The renumbering has to be a permutation of the indices, see IndexRenumbering.
+       *
+       * @param[in] renumbering  The new numbers of the indices.
+       *
+       * @tparam Renumbering  The type of the renumbering, e.g. IndexRenumbering.
+       */
+      template<typename Renumbering>
+      void renumberIndices(const Renumbering& renumbering) {
+        for(size_t pos = 0; pos < usedIndicesPos; ++pos) {
+          renumbering.apply(usedIndices[pos]);
+        }
+        for(size_t pos = 0; pos < unusedIndicesPos; ++pos) {
+          renumbering.apply(unusedIndices[pos]);
+        }
+
+        renumbering.permute(indexUse.data(), indexUse.size());
+      }
+
+      /**
+       * @brief Move the live indices into a dense range after the reserved indices and shrink the index vectors.
+       *
+       * All free indices are removed and the maximum global index is set to the end of the dense range, see
+       * IndexCompaction for details. All active variables need to be updated with IndexCompaction::apply
+       * afterwards. Since the indices of a recorded tape would become invalid, the method may only be called
+       * between recordings.
+       *
+       * Thread local tapes claim their indices from a shared range, therefore the compaction is not possible for
+       * them and an exception is thrown.
+       *
+       * @param[out] compaction  The new numbers of the indices.
+       *
+       * @tparam Compaction  The type of the compaction, e.g. IndexCompaction.
+       */
+      template<typename Compaction>
+      void compactIndices(Compaction& compaction) {
+        if(ThreadLocalTape) {
+          CODI_EXCEPTION("The indices of thread local tapes can not be compacted.");
+        }
+
+        Index reservedEnd = std::max(reservedIndices, (Index)1); // the zero index is never used
+        size_t oldSize = std::min((size_t)globalMaximumIndex, indexUse.size());
+
+        compaction.begin(globalMaximumIndex, reservedEnd);
+        for(size_t index = (size_t)reservedEnd; index < oldSize; ++index) {
+          if(0 != indexUse[index]) {
+            indexUse[compaction.addIndex((Index)index)] = indexUse[index];
+          }
+        }
+        globalMaximumIndex = compaction.getIndexEnd();
+
+        indexUse.resize(globalMaximumIndex);
+        indexUse.resize(std::max((size_t)globalMaximumIndex, indexSizeIncrement));
+        std::vector<Index>(indexUse).swap(indexUse);
+
+        std::vector<Index>().swap(usedIndices);
+        usedIndicesPos = 0;
+        std::vector<Index>(indexSizeIncrement).swap(unusedIndices);
+        unusedIndicesPos = 0;
+      }
+
       /**
        * @brief Get the maximum global
        *
@@ -334,6 +413,27 @@ namespace codi {
         return unusedIndices.capacity() + usedIndices.capacity();
       }
 
+      /**
+       * @brief Get the number of free indices which are smaller than the largest index in use.
+       *
+       * The value is zero if the live indices are dense.
+       *
+       * @return The number of gaps between the live indices.
+       */
+      size_t getNumberIndexGaps() const {
+        size_t gaps = 0;
+        size_t freeIndices = 0;
+        for(size_t index = 1; index < (size_t)globalMaximumIndex && index < indexUse.size(); ++index) {
+          if(0 == indexUse[index]) {
+            freeIndices += 1;
+          } else {
+            gaps = freeIndices;
+          }
+        }
+
+        return gaps;
+      }
+
       /**
        * @brief Add statistics about the used indices.
        *
@@ -341,6 +441,7 @@ namespace codi {
        *   maximum number of live indices,
        *   the current number of lives indices,
        *   the indices that are stored,
+       *   the free indices below the largest live index,
        *   the memory for the allocated indices and
        *   the memory for the index use vector.
        *
@@ -350,6 +451,7 @@ namespace codi {
         size_t maximumGlobalIndex     = (size_t)this->getMaximumGlobalIndex();
         size_t storedIndices          = (size_t)this->getNumberStoredIndices();
         size_t currentLiveIndices     = (size_t)this->getCurrentIndex() - this->getNumberStoredIndices();
+        size_t indexGaps              = this->getNumberIndexGaps();
 
         double memoryStoredIndices    = (double)storedIndices*(double)(sizeof(Index)) * BYTE_TO_MB;
         double memoryIndexUse         = (double)this->indexUse.size()*(double)(sizeof(Index)) * BYTE_TO_MB;
@@ -359,6 +461,7 @@ namespace codi {
         values.addData("Max. live indices", maximumGlobalIndex);
         values.addData("Cur. live indices", currentLiveIndices);
         values.addData("Indices stored", storedIndices);
+        values.addData("Index gaps", indexGaps);
         values.addData("Memory used", memoryStoredIndices, true, false);
         values.addData("Memory allocated", memoryAllocatedIndices, false, true);
         values.addData("Memory index use vec", memoryIndexUse, true, true);
@@ -374,13 +477,49 @@ namespace codi {
 
         codiAssert(unusedIndices.size() >= indexSizeIncrement);
 
+        if(ThreadLocalTape) {
+          globalMaximumIndex = SharedIndexRange<Index>::claimBlock(globalMaximumIndex, indexSizeIncrement);
+        }
+        checkIndexOverflow(globalMaximumIndex, indexSizeIncrement);
+
         for(size_t pos = 0; pos < indexSizeIncrement; ++pos) {
           unusedIndices[unusedIndicesPos + pos] = globalMaximumIndex + (Index)pos;
         }
 
         unusedIndicesPos = indexSizeIncrement;
         globalMaximumIndex += indexSizeIncrement;
-        indexUse.resize(globalMaximumIndex);
+        if(indexUse.size() < (size_t)globalMaximumIndex) {
+          indexUse.resize(globalMaximumIndex);
+        }
+      }
+
+      /**
+       * @brief Take over an index that was created by the handler of another thread.
+       *
+       * Since indices are not shared with thread local tapes, the variable that is given to this handler is the only
+       * user of the index.
+       *
+       * The index is not given back to the handler that created it. The use count of the index stays at one in the
+       * creating handler, such that this handler never reuses the index. The index is reused by the handler that
+       * frees it. If variables are only moved in one direction, e.g. from worker threads to the main thread, the
+       * worker handlers claim new blocks from the SharedIndexRange for the lost indices and the adjoint vectors grow
+       * accordingly.
+       *
+       * The maximum index of this handler is raised to the adopted index, such that the adjoint vector of the tape
+       * covers it when the index is reused.
+       *
+       * @param[in] index  The index of the variable.
+       */
+      CODI_INLINE void adoptIndex(const Index& index) {
+        if(indexUse.size() <= (size_t)index) {
+          indexUse.resize((size_t)index + 1);
+        }
+        if(globalMaximumIndex <= index) {
+          globalMaximumIndex = index + 1;
+        }
+        if(0 == indexUse[index]) {
+          indexUse[index] = 1;
+        }
       }
 
       CODI_NO_INLINE void increaseIndicesSize(std::vector<Index>& v) {
@@ -0,0 +1,88 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+#include "../../configure.h"
+#include "indexOverflow.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Hands out blocks of indices from a process wide range.
+   *
+   * The index handlers of different threads use the range if CODI_ThreadLocalTape is set. The blocks of all
+   * handlers with the same index type are disjoint.
+   *
+   * @tparam Index  The type for the handled indices.
+   */
+  template<typename Index>
+  struct SharedIndexRange {
+
+      /**
+       * @brief Claim a new block of indices.
+       *
+       * The first index of the block is at least the given minimum.
+       *
+       * @param[in] minimum  The smallest index the handler can use.
+       * @param[in]    size  The number of indices in the block.
+       *
+       * @return The first index of the block.
+       */
+      static Index claimBlock(const Index minimum, const size_t size) {
+        std::atomic<Index>& next = getNextIndex();
+
+        Index cur = next.load(std::memory_order_relaxed);
+        Index start;
+        do {
+          start = std::max(cur, minimum);
+          checkIndexOverflow(start, size);
+        } while(!next.compare_exchange_weak(cur, start + (Index)size, std::memory_order_relaxed));
+
+        return start;
+      }
+
+    private:
+
+      /**
+       * @brief The first index that has not been claimed by a handler.
+       *
+       * @return The reference to the process wide value.
+       */
+      static std::atomic<Index>& getNextIndex() {
+        static std::atomic<Index> next(0);
+
+        return next;
+      }
+  };
+}
@@ -0,0 +1,576 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../../configure.h"
+#include "../../tools/tapeValues.hpp"
+#include "indexOverflow.hpp"
+#include "sharedIndexRange.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Handles the indices that can be used and reused, counts the use of indices and reuses the smallest free index.
+   *
+   * The handler behaves like the ReuseIndexHandlerUseCount but the freed indices are not reused in the LIFO order.
+   * The free indices are stored in bitmaps with one bit per index and the smallest free index is used for a new
+   * variable. The live indices stay therefore dense and the adjoint vector is accessed in a smaller region.
+   *
+   * The search starts at the lowest word which can contain a free index. Creating an index is therefore usually as fast
+   * as with the LIFO lists, but can require a scan over the bitmap if the free indices are sparse.
+   *
+   * @tparam IndexType  The type for the handled indices.
+   */
+  template<typename IndexType>
+  class SortedReuseIndexHandlerUseCount {
+    public:
+      /**
+       * @brief The type definition for other tapes who want to access the type.
+       */
+      typedef IndexType Index;
+
+      /**
+       * @brief If it is required to write an assign statement after the index is copied.
+       *
+       * Thread local tapes can not share an index between variables, since the use count is only known to one thread.
+       */
+      const static bool AssignNeedsStatement = OptDisableAssignOptimization || ThreadLocalTape;
+
+      /**
+       * @brief Indicates if the index handler privides linear increasing indices.
+       *
+       * false for this index manager.
+       */
+      static const bool IsLinear = false;
+
+    private:
+
+      /** @brief The type for the words of the bitmaps. */
+      typedef uint64_t Word;
+
+      /** @brief The number of indices in one word of the bitmaps. */
+      static const size_t WordBits = 64;
+
+      /** @brief The maximum index that was used over the whole process */
+      Index globalMaximumIndex;
+
+      /**
+       * @brief The bitmap of the indices that are available for reuse.
+       *
+       * These indices have already been used.
+       */
+      std::vector<Word> usedBits;
+
+      /**
+       * @brief The bitmap of the indices that are available for reuse.
+       *
+       * These indices have not been used in the current tape.
+       */
+      std::vector<Word> unusedBits;
+
+      /** @brief All words before this one have no bit set in usedBits. */
+      size_t usedWordPos;
+
+      /** @brief All words before this one have no bit set in unusedBits. */
+      size_t unusedWordPos;
+
+      /** @brief The number of indices in usedBits. */
+      size_t usedIndicesCount;
+
+      /** @brief The number of indices in unusedBits. */
+      size_t unusedIndicesCount;
+
+      /**
+       * @brief The vector that counts for the indices how often they are used.
+       */
+      std::vector<Index> indexUse;
+
+      /**
+       * @brief The size increment for all index vectors and how many indices are generated.
+       */
+      size_t indexSizeIncrement;
+
+      /**
+       * @brief Indicates the destruction of the index handler.
+       *
+       * Required to prevent segmentation faults if varaibles are deleted after the index handler.
+       */
+      bool valid;
+
+    public:
+
+      /**
+       * @brief Create a handler for index reuse.
+       *
+       * The argument reserveIndices will cause the index manager to reserve the first n indices, so that there are
+       * not used by the index manager and are freely available to anybody.
+       *
+       * @param[in] reserveIndices  The number of indices that are reserved and not used by the manager.
+       */
+      SortedReuseIndexHandlerUseCount(const Index reserveIndices) :
+        globalMaximumIndex(reserveIndices),
+        usedBits(),
+        unusedBits(),
+        usedWordPos(0),
+        unusedWordPos(0),
+        usedIndicesCount(0),
+        unusedIndicesCount(0),
+        indexUse(DefaultSmallChunkSize),
+        indexSizeIncrement(DefaultSmallChunkSize),
+        valid(true)
+      {
+        generateNewIndices();
+      }
+
+      ~SortedReuseIndexHandlerUseCount() {
+        valid = false;
+      }
+
+      /**
+       * @brief Free the index that is given to the method.
+       *
+       * The index is added to the bitmap of the used indices if it is no longer used by any variable.
+       *
+       * @param[in,out] index  The index that is freed. It is set to zero in the method.
+       */
+      CODI_INLINE void freeIndex(Index& index) {
+        if(valid && 0 != index) { // do not free the zero index
+          if(ThreadLocalTape) {
+            adoptIndex(index);
+          }
+
+          indexUse[index] -= 1;
+
+          if(indexUse[index] == 0) { // only free the index if it not used any longer
+
+#if CODI_IndexHandle
+            handleIndexFree(index);
+#endif
+
+            if(ThreadLocalTape) {
+              ensureBitsSize((size_t)index + 1);
+            }
+
+            setBit(usedBits, usedWordPos, index);
+            usedIndicesCount += 1;
+          }
+
+          index = 0;
+        }
+      }
+
+      /**
+       * @brief Generate a new index.
+       *
+       * The smallest index from both bitmaps is used.
+       *
+       * @return The new index that can be used.
+       */
+      CODI_INLINE Index createIndex() {
+        if(0 == usedIndicesCount + unusedIndicesCount) {
+          generateNewIndices();
+        }
+
+        size_t wordPos = std::min(usedWordPos, unusedWordPos);
+        while(0 == (usedBits[wordPos] | unusedBits[wordPos])) {
+          wordPos += 1;
+        }
+        usedWordPos = std::max(usedWordPos, wordPos);
+        unusedWordPos = std::max(unusedWordPos, wordPos);
+
+        const Word usedWord = usedBits[wordPos];
+        const Word unusedWord = unusedBits[wordPos];
+        const size_t bit = findFirstBit(usedWord | unusedWord);
+        const Word mask = (Word)1 << bit;
+
+        if(0 != (usedWord & mask)) {
+          usedBits[wordPos] = usedWord & ~mask;
+          usedIndicesCount -= 1;
+        } else {
+          unusedBits[wordPos] = unusedWord & ~mask;
+          unusedIndicesCount -= 1;
+        }
+
+        Index index = (Index)(wordPos * WordBits + bit);
+
+#if CODI_IndexHandle
+        handleIndexCreate(index);
+#endif
+
+        indexUse[index] = 1;
+
+        return index;
+      }
+
+      /**
+       * @brief Generate a new index that has not been used in the tape.
+       *
+       * @return The new index that can be used.
+       */
+      CODI_INLINE Index createUnusedIndex() {
+        if(0 == unusedIndicesCount) {
+          generateNewIndices();
+        }
+
+        while(0 == unusedBits[unusedWordPos]) {
+          unusedWordPos += 1;
+        }
+
+        const Word word = unusedBits[unusedWordPos];
+        const size_t bit = findFirstBit(word);
+        unusedBits[unusedWordPos] = word & ~((Word)1 << bit);
+        unusedIndicesCount -= 1;
+
+        Index index = (Index)(unusedWordPos * WordBits + bit);
+
+#if CODI_IndexHandle
+        handleIndexCreate(index);
+#endif
+        indexUse[index] = 1;
+
+        return index;
+      }
+
+      /**
+       * @brief Check if the index is active and if it is only used by this instance if not a new index is generated.
+       *
+       * @param[in,out] index The current value of the index. If 0 then a new index is generated.
+       */
+      CODI_INLINE void assignIndex(Index& index) {
+        if(0 == index) {
+          index = this->createIndex();
+        } else if(ThreadLocalTape) {
+          adoptIndex(index);
+        } else if(indexUse[index] > 1) {
+          indexUse[index] -= 1;
+
+          index = this->createIndex();
+        }
+      }
+
+      /**
+       * @brief Check if the index is active if yes it is deleted and an unused index is generated.
+       *
+       * @param[in,out] index The current value of the index.
+       */
+      CODI_INLINE void assignUnusedIndex(Index& index) {
+        freeIndex(index); // zero check is performed inside
+
+        index = this->createUnusedIndex();
+      }
+
+      /**
+       * @brief Copies the index from rhs to lhs.
+       *
+       * The lhs index is freed and then the use of the rhs index
+       * is incremented by one.
+       *
+       * @param[in,out] lhs  The index of the lhs. It is overwritten with the index of the rhs.
+       * @param[in]    rhs  The index of the rhs.
+       */
+      CODI_INLINE void copyIndex(Index& lhs, const Index& rhs) {
+        if(!AssignNeedsStatement) {
+          // skip the logic if the indices are the same.
+          // This also prevents the bug, that if &lhs == &rhs the left hand side will always be deactivated.
+          if(lhs != rhs) {
+            freeIndex(lhs);
+
+            if(0 != rhs) { // do not handle the zero index
+              indexUse[rhs] += 1;
+
+              lhs = rhs;
+            }
+          }
+        } else {
+            // path if assign optimizations are disabled
+            assignIndex(lhs);
+        }
+      }
+
+      /**
+       * @brief Adds all used indices to the unused indices.
+       */
+      CODI_INLINE void reset() {
+        for(size_t wordPos = usedWordPos; wordPos < usedBits.size(); ++wordPos) {
+          unusedBits[wordPos] |= usedBits[wordPos];
+          usedBits[wordPos] = 0;
+        }
+
+        unusedWordPos = std::min(unusedWordPos, usedWordPos);
+        usedWordPos = usedBits.size();
+        unusedIndicesCount += usedIndicesCount;
+        usedIndicesCount = 0;
+      }
+
+      /**
+       * @brief Replace the stored indices with their new numbers.
+       *
+       * The renumbering has to be a permutation of the indices, see IndexRenumbering.
+       *
+       * @param[in] renumbering  The new numbers of the indices.
+       *
+       * @tparam Renumbering  The type of the renumbering, e.g. IndexRenumbering.
+       */
+      template<typename Renumbering>
+      void renumberIndices(const Renumbering& renumbering) {
+        renumberBits(renumbering, usedBits, usedWordPos);
+        renumberBits(renumbering, unusedBits, unusedWordPos);
+
+        renumbering.permute(indexUse.data(), indexUse.size());
+      }
+
+      /**
+       * @brief Get the maximum global
+       *
+       * @return The maximum index that was used during the lifetime of this index handler.
+       */
+      CODI_INLINE Index getMaximumGlobalIndex() const {
+        return globalMaximumIndex;
+      }
+
+      /**
+       * @brief Get the current maximum index.
+       *
+       * @return The current maximum index that is in use.
+       */
+      CODI_INLINE Index getCurrentIndex() const {
+        return globalMaximumIndex;
+      }
+
+      /**
+       * @brief Get the number of the stored indices.
+       *
+       * @return The number of stored indices.
+       */
+      size_t getNumberStoredIndices() const {
+        return unusedIndicesCount + usedIndicesCount;
+      }
+
+      /**
+       * @brief Get the number of the allocated indices.
+       *
+       * @return The number of the indices that the bitmaps can hold.
+       */
+      size_t getNumberAllocatedIndices() const {
+        return unusedBits.capacity() * WordBits;
+      }
+
+      /**
+       * @brief Get the number of free indices which are smaller than the largest index in use.
+       *
+       * The value is zero if the live indices are dense.
+       *
+       * @return The number of gaps between the live indices.
+       */
+      size_t getNumberIndexGaps() const {
+        size_t gaps = 0;
+        size_t freeIndices = 0;
+        for(size_t index = 1; index < (size_t)globalMaximumIndex; ++index) {
+          const Word mask = (Word)1 << (index % WordBits);
+          const size_t wordPos = index / WordBits;
+          if(0 != ((usedBits[wordPos] | unusedBits[wordPos]) & mask)) {
+            freeIndices += 1;
+          } else {
+            gaps = freeIndices;
+          }
+        }
+
+        return gaps;
+      }
+
+      /**
+       * @brief Add statistics about the used indices.
+       *
+       * Adds the
+       *   maximum number of live indices,
+       *   the current number of lives indices,
+       *   the indices that are stored,
+       *   the free indices below the largest live index,
+       *   the memory for the index bitmaps and
+       *   the memory for the index use vector.
+       *
+       * @param[in,out] values  The values where the information is added to.
+       */
+      void addValues(TapeValues& values) const {
+        size_t maximumGlobalIndex     = (size_t)this->getMaximumGlobalIndex();
+        size_t storedIndices          = (size_t)this->getNumberStoredIndices();
+        size_t currentLiveIndices     = (size_t)this->getCurrentIndex() - this->getNumberStoredIndices();
+        size_t indexGaps              = this->getNumberIndexGaps();
+
+        double memoryStoredIndices    = (double)(usedBits.size() + unusedBits.size())*(double)(sizeof(Word)) * BYTE_TO_MB;
+        double memoryIndexUse         = (double)this->indexUse.size()*(double)(sizeof(Index)) * BYTE_TO_MB;
+        double memoryAllocatedIndices = (double)(usedBits.capacity() + unusedBits.capacity())*(double)(sizeof(Word)) * BYTE_TO_MB;
+
+        values.addSection("Indices");
+        values.addData("Max. live indices", maximumGlobalIndex);
+        values.addData("Cur. live indices", currentLiveIndices);
+        values.addData("Indices stored", storedIndices);
+        values.addData("Index gaps", indexGaps);
+        values.addData("Memory used", memoryStoredIndices, true, false);
+        values.addData("Memory allocated", memoryAllocatedIndices, false, true);
+        values.addData("Memory index use vec", memoryIndexUse, true, true);
+      }
+
+    private:
+
+      /**
+       * @brief Get the position of the lowest set bit.
+       *
+       * @param[in] word  A word with at least one bit set.
+       * @return The position of the lowest set bit.
+       */
+      static CODI_INLINE size_t findFirstBit(const Word word) {
+        codiAssert(0 != word);
+
+#if defined(__GNUC__)
+        return (size_t)__builtin_ctzll(word);
+#else
+        size_t bit = 0;
+        while(0 == (word & ((Word)1 << bit))) {
+          bit += 1;
+        }
+        return bit;
+#endif
+      }
+
+      /**
+       * @brief Mark an index as free in a bitmap.
+       *
+       * @param[in,out]    bits  The bitmap.
+       * @param[in,out] wordPos  The first word of the bitmap that can have a set bit.
+       * @param[in]       index  The free index.
+       */
+      static CODI_INLINE void setBit(std::vector<Word>& bits, size_t& wordPos, const Index& index) {
+        const size_t pos = (size_t)index / WordBits;
+
+        bits[pos] |= (Word)1 << ((size_t)index % WordBits);
+        wordPos = std::min(wordPos, pos);
+      }
+
+      /**
+       * @brief Move the bits of a bitmap to the new indices.
+       *
+       * @param[in]  renumbering  The new numbers of the indices.
+       * @param[in,out]     bits  The bitmap.
+       * @param[out]     wordPos  The first word of the bitmap that can have a set bit.
+       *
+       * @tparam Renumbering  The type of the renumbering, e.g. IndexRenumbering.
+       */
+      template<typename Renumbering>
+      static void renumberBits(const Renumbering& renumbering, std::vector<Word>& bits, size_t& wordPos) {
+        std::vector<Word> oldBits(bits.size(), 0);
+        oldBits.swap(bits);
+
+        wordPos = bits.size();
+        for(size_t pos = 0; pos < oldBits.size(); ++pos) {
+          Word word = oldBits[pos];
+          while(0 != word) {
+            const size_t bit = findFirstBit(word);
+            word &= word - 1;
+
+            setBit(bits, wordPos, renumbering.getNewIndex((Index)(pos * WordBits + bit)));
+          }
+        }
+      }
+
+      /**
+       * @brief Ensure that the bitmaps can hold the given number of indices.
+       *
+       * @param[in] size  The number of indices.
+       */
+      void ensureBitsSize(const size_t size) {
+        size_t wordCount = (size + WordBits - 1) / WordBits;
+        if(usedBits.size() < wordCount) {
+          usedBits.resize(wordCount, 0);
+          unusedBits.resize(wordCount, 0);
+        }
+      }
+
+      CODI_NO_INLINE void generateNewIndices() {
+        // method is only called when no free indices are available
+
+        if(ThreadLocalTape) {
+          globalMaximumIndex = SharedIndexRange<Index>::claimBlock(globalMaximumIndex, indexSizeIncrement);
+        }
+        checkIndexOverflow(globalMaximumIndex, indexSizeIncrement);
+
+        ensureBitsSize((size_t)globalMaximumIndex + indexSizeIncrement);
+
+        for(size_t pos = 0; pos < indexSizeIncrement; ++pos) {
+          Index index = globalMaximumIndex + (Index)pos;
+          if(0 != index) { // the zero index is the passive index
+            setBit(unusedBits, unusedWordPos, index);
+            unusedIndicesCount += 1;
+          }
+        }
+
+        globalMaximumIndex += indexSizeIncrement;
+        if(indexUse.size() < (size_t)globalMaximumIndex) {
+          indexUse.resize(globalMaximumIndex);
+        }
+      }
+
+      /**
+       * @brief Take over an index that was created by the handler of another thread.
+       *
+       * Since indices are not shared with thread local tapes, the variable that is given to this handler is the only
+       * user of the index.
+       *
+       * The index is not given back to the handler that created it. The use count of the index stays at one in the
+       * creating handler, such that this handler never reuses the index. The index is reused by the handler that
+       * frees it. If variables are only moved in one direction, e.g. from worker threads to the main thread, the
+       * worker handlers claim new blocks from the SharedIndexRange for the lost indices and the adjoint vectors grow
+       * accordingly.
+       *
+       * The maximum index of this handler is raised to the adopted index, such that the adjoint vector of the tape
+       * covers it when the index is reused.
+       *
+       * @param[in] index  The index of the variable.
+       */
+      CODI_INLINE void adoptIndex(const Index& index) {
+        if(indexUse.size() <= (size_t)index) {
+          indexUse.resize((size_t)index + 1);
+        }
+        if(globalMaximumIndex <= index) {
+          globalMaximumIndex = index + 1;
+          ensureBitsSize((size_t)index + 1);
+        }
+        if(0 == indexUse[index]) {
+          indexUse[index] = 1;
+        }
+      }
+  };
+}
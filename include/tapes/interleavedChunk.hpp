@@ -0,0 +1,329 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#include "../configure.h"
+#include "chunk.hpp"
+#include "chunkVector.hpp"
+#include "pointerHandle.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief One record of an interleaved chunk.
+   *
+   * @tparam Data1  The first type of the stored data.
+   * @tparam Data2  The second type of the stored data.
+   */
+  template<typename Data1, typename Data2>
+  struct InterleavedEntry {
+    Data1 data1; /**< First data item of the record */
+    Data2 data2; /**< Second data item of the record */
+  };
+
+  /**
+   * @brief Pointer like access to one member of an array of records.
+   *
+   * The access ptr[i] yields the member of the i-th record. The type can be used in the
+   * evaluation routines of the tapes instead of a plain pointer.
+   *
+   * @tparam  Entry  The record type.
+   * @tparam   Data  The type of the accessed member.
+   * @tparam member  The accessed member of the record.
+   */
+  template<typename Entry, typename Data, Data Entry::*member>
+  struct InterleavedPointer {
+    Entry* entries; /**< The start of the record array */
+
+    /**
+     * @brief Access the member of a record.
+     *
+     * @param[in] pos  The position of the record.
+     * @return The member of the record.
+     */
+    CODI_INLINE Data& operator[](const size_t& pos) const {
+      return entries[pos].*member;
+    }
+  };
+
+  /**
+   * @brief Chunk with two data items which are interleaved in one array.
+   *
+   * The items are stored as an array of records instead of two separate arrays. The reverse sweep
+   * then reads one memory stream instead of two. The record may contain padding, e.g. a double
+   * and a 32 bit integer occupy 16 bytes instead of 12 bytes.
+   *
+   * @tparam     Data1  The first type of the stored data.
+   * @tparam     Data2  The second type of the stored data.
+   * @tparam Allocator  The allocator policy for the data array, see ChunkAllocatorBase.
+   */
+  template<typename Data1, typename Data2, typename Allocator = PoolChunkAllocator>
+  struct InterleavedChunk2 : public ChunkInterface {
+
+    /** @brief The record type of the chunk. */
+    typedef InterleavedEntry<Data1, Data2> Entry;
+
+    /**
+     * @brief The size of one record including the padding.
+     */
+    const static size_t EntrySize = sizeof(Entry);
+
+    Entry* data; /**< The records of the chunk */
+
+    /**
+     * @brief Creates the data array with the given size.
+     *
+     * @param[in] size  The size for the data array.
+     */
+    InterleavedChunk2(const size_t& size) : ChunkInterface(size), data(NULL) {
+      allocateData();
+    }
+
+    /**
+     * @brief Deletes the data array.
+     */
+    ~InterleavedChunk2() {
+      deleteData();
+    }
+
+    /**
+     * @brief Write the data of the chunk to the io handle.
+     *
+     * The data is not written in a portable way.
+     *
+     * @param[in] handle  The handle for the writing of the data.
+     */
+    void writeData(CoDiIoHandle& handle) const {
+      handle.writeData(data, size);
+    }
+
+    /**
+     * @brief Read the data of the chunk from the io handle.
+     *
+     * The data is not read in a portable way.
+     *
+     * @param[in] handle  The handle for the reading of the data.
+     */
+    void readData(CoDiIoHandle& handle) {
+      allocateData();
+
+      handle.readData(data, size);
+    }
+
+    /**
+     * @brief Allocates the data array.
+     */
+    void allocateData() {
+      if(NULL == data) {
+        data = Allocator::template allocateArray<Entry>(size);
+      }
+    }
+
+    /**
+     * @brief Deletes the data array.
+     */
+    void deleteData() {
+      if(NULL != data) {
+        Allocator::deleteArray(data, size);
+        data = NULL;
+      }
+    }
+
+    /**
+     * @brief Swap the data of this chunk with the other chunk.
+     *
+     * @param[in,out] other  The other chunk.
+     */
+    void swap(InterleavedChunk2<Data1, Data2, Allocator>& other) {
+      this->swapBase(other);
+
+      std::swap(data, other.data);
+    }
+
+    /**
+     * @brief Resize the data in the chunk.
+     * @param size  The new size for the data.
+     */
+    void resize(const size_t &size) {
+      this->~InterleavedChunk2();
+      new (this) InterleavedChunk2(size);
+    }
+
+    /**
+     * @brief Set the data values to the current position and increment the used size.
+     * @param value1  The value for the first data item.
+     * @param value2  The value for the second data item.
+     */
+    CODI_INLINE void setDataAndMove(const Data1& value1, const Data2& value2) {
+      codiAssert(getUnusedSize() != 0);
+      data[usedSize].data1 = value1;
+      data[usedSize].data2 = value2;
+      ++usedSize;
+    }
+
+    /**
+     * @brief Returns the record array at the given position.
+     * @param   index  The index in the data array.
+     * @param pointer  Pointer that is set to the record at the position.
+     */
+    CODI_INLINE void dataPointer(const size_t& index, Entry* &pointer) {
+      codiAssert(index <= ChunkInterface::size);
+      pointer = codi::addressof(data[index]);
+    }
+  };
+
+  /**
+   * @brief Specialization for PointerHandle with an InterleavedChunk2 type.
+   *
+   * Both pointers address the same record array.
+   *
+   * @tparam     Data1  The first data type for the chunk.
+   * @tparam     Data2  The second data type for the chunk.
+   * @tparam Allocator  The allocator policy of the chunk.
+   */
+  template<typename Data1, typename Data2, typename Allocator>
+  struct PointerHandle<InterleavedChunk2<Data1, Data2, Allocator> > {
+      /** @brief The record type of the chunk. */
+      typedef InterleavedEntry<Data1, Data2> Entry;
+
+      typedef InterleavedPointer<Entry, Data1, &Entry::data1> Pointer1; /**< Pointer type for the first data item. */
+      typedef InterleavedPointer<Entry, Data2, &Entry::data2> Pointer2; /**< Pointer type for the second data item. */
+
+      Pointer1 p1; /**< Pointer for the first data item. */
+      Pointer2 p2; /**< Pointer for the second data item. */
+
+      /**
+       * @brief Set the internal pointers to the the data of the chunk at the
+       * specific position.
+       *
+       * @param[in]     dataPos  The position of the data in the chunk that is set to the pointers.
+       * @param[in,out]   chunk  The chunk from which the data is gained.
+       */
+      void setPointers(const size_t& dataPos, InterleavedChunk2<Data1, Data2, Allocator>* chunk) {
+        chunk->dataPointer(dataPos, p1.entries);
+        p2.entries = p1.entries;
+      }
+
+      /**
+       * @brief Call the function object with the arguments and the pointers from this handle object.
+       *
+       * The call is:
+       * func(<pointers> , <args>);
+       *
+       * @param[in]     func  The function object which is called with the data.
+       * @param[in,out] args  The additional arguments for the function call.
+       */
+      template<typename FuncObj, typename ... Args>
+      void call(FuncObj& func, Args&&... args) {
+        func(p1, p2, std::forward<Args>(args)...);
+      }
+
+      /**
+       * @brief Call reverse evaluation on the nested vector with the pointers from this handle.
+       *
+       * @param[in,out] nested  The nested vector on which the reverse evaluation is called.
+       * @param[in,out]   args  The additional arguments for the reverse evaluation.
+       */
+      template<typename Nested, typename ... Args>
+      CODI_INLINE void callNestedReverse(Nested* nested, Args&&... args) {
+        nested->evaluateReverse(std::forward<Args>(args)..., p1, p2);
+      }
+
+      /**
+       * @brief Call forward evaluation on the nested vector with the pointers from this handle.
+       *
+       * @param[in,out] nested  The nested vector on which the forward evaluation is called.
+       * @param[in,out]   args  The additional arguments for the reverse evaluation.
+       */
+      template<typename Nested, typename ... Args>
+      CODI_INLINE void callNestedForward(Nested* nested, Args&&... args) {
+        nested->evaluateForward(std::forward<Args>(args)..., p1, p2);
+      }
+  };
+
+  /**
+   * @brief Specialization for InterleavedChunk2.
+   *
+   * @tparam         Data1  The first data type for the chunk.
+   * @tparam         Data2  The second data type for the chunk.
+   * @tparam     Allocator  The current allocator policy.
+   * @tparam  NewAllocator  The new allocator policy.
+   */
+  template<typename Data1, typename Data2, typename Allocator, typename NewAllocator>
+  struct ChunkAllocatorRebind<InterleavedChunk2<Data1, Data2, Allocator>, NewAllocator> {
+    /** @brief The chunk with the new allocator. */
+    typedef InterleavedChunk2<Data1, Data2, NewAllocator> Type;
+  };
+
+  /**
+   * @brief Selects the interleaved chunk for the Jacobi chunks.
+   *
+   * Chunk2 types with a floating point type and an integral type are replaced by InterleavedChunk2.
+   * All other chunks are not changed.
+   *
+   * @tparam Chunk  The memory chunk.
+   */
+  template<typename Chunk>
+  struct InterleavedChunkSelect {
+    /** @brief The chunk type for the vector. */
+    typedef Chunk Type;
+  };
+
+  /**
+   * @brief Specialization for Chunk2 types.
+   *
+   * @tparam     Data1  The first data type for the chunk.
+   * @tparam     Data2  The second data type for the chunk.
+   * @tparam Allocator  The allocator policy for the data arrays.
+   */
+  template<typename Data1, typename Data2, typename Allocator>
+  struct InterleavedChunkSelect<Chunk2<Data1, Data2, Allocator> > {
+    /** @brief The chunk type for the vector. */
+    typedef typename std::conditional<std::is_floating_point<Data1>::value && std::is_integral<Data2>::value,
+                                      InterleavedChunk2<Data1, Data2, Allocator>,
+                                      Chunk2<Data1, Data2, Allocator> >::type Type;
+  };
+
+  /**
+   * @brief A chunk vector which stores the Jacobies and indices as interleaved records.
+   *
+   * The vector can be used as the DataVector argument of the JacobiTapeTypes. Only the Jacobi chunks are
+   * interleaved, see InterleavedChunkSelect.
+   *
+   * @tparam    ChunkData  The memory chunk for the data.
+   * @tparam NestedVector  A nested chunk vector used for position information.
+   */
+  template<typename ChunkData, typename NestedVector>
+  using InterleavedChunkVector = ChunkVector<typename InterleavedChunkSelect<ChunkData>::Type, NestedVector>;
+}
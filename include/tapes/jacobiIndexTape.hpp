@@ -30,16 +30,26 @@
 
 #include <iostream>
 #include <cstddef>
+#include <limits>
 #include <tuple>
+#include <type_traits>
 
 #include "../activeReal.hpp"
 #include "../typeFunctions.hpp"
 #include "chunk.hpp"
 #include "chunkVector.hpp"
+#include "dirtyAdjointRange.hpp"
 #include "externalFunctions.hpp"
+#include "jacobiStatement.hpp"
+#include "indexCompaction.hpp"
+#include "indexRenumbering.hpp"
+#include "passThroughChunkVector.hpp"
 #include "reverseTapeInterface.hpp"
 #include "singleChunkVector.hpp"
+#include "vertexElimination.hpp"
+#include "zeroPageArray.hpp"
 #include "../tapeTypes.hpp"
+#include "../tools/blockAdjoint.hpp"
 #include "../tools/tapeValues.hpp"
 
 /**
@@ -66,14 +76,21 @@ namespace codi {
     typedef RTT BaseTypes;
 
     /** @brief The data for each statement. */
-    typedef Chunk2<StatementInt, typename IndexHandler::Index> StatementChunk;
+    typedef Chunk2<JacobiStatementInt, typename IndexHandler::Index> StatementChunk;
     /** @brief The chunk vector for the statement data. */
     typedef ChunkVector<StatementChunk, EmptyChunkVector> StatementVector;
 
+    /** @brief The data for the arguments with the jacobies 1.0 and -1.0, see ImplicitUnitJacobies. */
+    typedef Chunk1<typename IndexHandler::Index> UnitChunk;
+    /** @brief The chunk vector for the unit arguments. Without ImplicitUnitJacobies it passes through to the statements. */
+    typedef typename std::conditional<ImplicitUnitJacobies,
+                                      ChunkVector<UnitChunk, StatementVector>,
+                                      PassThroughChunkVector<UnitChunk, StatementVector> >::type UnitVector;
+
     /** @brief The data for the jacobies of each statement */
     typedef Chunk2< Real, typename IndexHandler::Index> JacobiChunk;
     /** @brief The chunk vector for the jacobi data. */
-    typedef ChunkVector<JacobiChunk, StatementVector> JacobiVector;
+    typedef ChunkVector<JacobiChunk, UnitVector> JacobiVector;
 
     /** @brief The data for the external functions. */
     typedef Chunk2<ExternalFunction,typename JacobiVector::Position> ExternalFunctionChunk;
@@ -99,6 +116,8 @@ namespace codi {
    *
    * externalFunctions -> jacobiData -> statements
    *
+   * If ImplicitUnitJacobies is enabled, the unit data is nested between the jacobi data and the statements.
+   *
    * The size of the tape can be set with the resize function,
    * the tape will allocate enough chunks such that the given data requirements will fit into the chunks.
    *
@@ -125,7 +144,7 @@ namespace codi {
     EmptyChunkVector emptyVector;
 
     /** @brief The index handler for the active real's. */
-    static typename TapeTypes::IndexHandler indexHandler;
+    static CODI_TAPE_STORAGE typename TapeTypes::IndexHandler indexHandler;
 
     /** @brief Enables code path in CoDiPack that are optimized for Jacobi taping */
     static const bool AllowJacobiOptimization = true;
@@ -133,6 +152,18 @@ namespace codi {
     /** @brief This tape requires no primal value handling. */
     static const bool RequiresPrimalReset = false;
 
+    /** @brief The evaluation only reads the tape. It can be evaluated by several threads with different adjoint vectors. */
+    static const bool AllowConcurrentEvaluation = true;
+
+    /** @brief The renumbering of the indices in a tape range, see renumberIndices. */
+    typedef IndexRenumbering<Index> IndexRenumberingType;
+
+    /** @brief The compaction of the index space, see compactIndices. */
+    typedef IndexCompaction<Index> IndexCompactionType;
+
+    /** @brief The elimination of intermediate variables in a tape range, see eliminateIntermediates. */
+    typedef VertexElimination<Real, Index> VertexEliminationType;
+
     // The class name of the tape. Required by the modules.
     #define TAPE_NAME JacobiIndexTape
 
@@ -150,6 +181,7 @@ namespace codi {
     #include "modules/statementModule.tpp"
 
     #define CHILD_VECTOR_TYPE StmtVector
+    #define UNIT_VECTOR_TYPE typename TapeTypes::UnitVector
     #define VECTOR_TYPE typename TapeTypes::JacobiVector
     #include "modules/jacobiModule.tpp"
 
@@ -172,9 +204,11 @@ namespace codi {
       emptyVector(),
       /* defined in tapeBaseModule */adjoints(NULL),
       /* defined in tapeBaseModule */adjointsSize(0),
+      /* defined in tapeBaseModule */dirtyAdjoints(),
       /* defined in tapeBaseModule */active(false),
       /* defined in statementModule */stmtVector(DefaultChunkSize, &emptyVector),
-      /* defined in jacobiModule */jacobiVector(DefaultChunkSize, &stmtVector),
+      /* defined in jacobiModule */unitVector(DefaultChunkSize, &stmtVector),
+      /* defined in jacobiModule */jacobiVector(DefaultChunkSize, &unitVector),
       /* defined in externalFunctionsModule */extFuncVector(1000, &jacobiVector) {
     }
 
@@ -220,9 +254,12 @@ namespace codi {
 
           if(IndexHandler::AssignNeedsStatement) {
             stmtVector.reserveItems(1);
-            jacobiVector.reserveItems(1);
-            jacobiVector.setDataAndMove(PassiveReal(1.0), rhs.getGradientData());
-            stmtVector.setDataAndMove((StatementInt)1, lhsIndex);
+            reserveJacobiEntries(1);
+
+            const size_t startUnitSize = getUnitChunkPosition();
+            pushArgument(PassiveReal(1.0), rhs.getGradientData());
+            const StatementInt units = (StatementInt)(getUnitChunkPosition() - startUnitSize);
+            stmtVector.setDataAndMove(createJacobiStatement(1 - units, units), lhsIndex);
           }
         } else {
           indexHandler.freeIndex(lhsIndex);
@@ -257,7 +294,7 @@ namespace codi {
      */
     CODI_INLINE void clearAdjoints(const Position& start, const Position& end){
       if(NULL != adjoints) {
-        auto clearFunc = [this] (StatementInt* stmtSize, Index* index) {
+        auto clearFunc = [this] (JacobiStatementInt* stmtSize, Index* index) {
           CODI_UNUSED(stmtSize);
 
           if(*index < adjointsSize) {
@@ -265,8 +302,55 @@ namespace codi {
           }
         };
 
-        stmtVector.forEachReverse(start.inner.inner, end.inner.inner, clearFunc);
+        stmtVector.forEachReverse(getStmtPosition(start.inner.inner), getStmtPosition(end.inner.inner), clearFunc);
+      }
+    }
+
+    /**
+     * @brief Call the function for each index of the adjoint vector that an evaluation of the range accesses.
+     *
+     * The function is called for the left hand side and the arguments of all statements in the range. An index can
+     * be reported several times. Ranges with external functions are not inspected, since the external functions
+     * can access arbitrary adjoint values.
+     *
+     * It has to hold start >= end.
+     *
+     * @param[in]    start  The start of the range.
+     * @param[in]      end  The end of the range.
+     * @param[in,out] func  The function which is called with each index.
+     *
+     * @return false if the range contains external functions. The function is not called in this case.
+     *
+     * @tparam Func  Needs to be callable with an Index.
+     */
+    template<typename Func>
+    bool forEachAdjointIndex(const Position& start, const Position& end, Func& func) {
+      if(start.chunk != end.chunk || start.data != end.data) {
+        return false;
+      }
+
+      auto stmtFunc = [&func] (JacobiStatementInt* numberOfArguments, Index* lhsIndex) {
+        CODI_UNUSED(numberOfArguments);
+
+        func(*lhsIndex);
+      };
+      stmtVector.forEachReverse(getStmtPosition(start.inner.inner), getStmtPosition(end.inner.inner), stmtFunc);
+
+      auto argFunc = [&func] (JacobiDataPointer jacobi, JacobiIndexPointer index) {
+        CODI_UNUSED(jacobi);
+
+        func(index[0]);
+      };
+      jacobiVector.forEachReverse(start.inner, end.inner, argFunc);
+
+      if(ImplicitUnitJacobies) {
+        auto unitFunc = [&func] (UnitIndexPointer unit) {
+          func(unit[0] >> UnitJacobiTagBits);
+        };
+        unitVector.forEachReverse(start.inner.inner, end.inner.inner, unitFunc);
       }
+
+      return true;
     }
 
     /**
@@ -291,6 +375,193 @@ namespace codi {
       return getExtFuncZeroPosition();
     }
 
+    /**
+     * @brief Renumber the indices of a tape range such that the reverse evaluation accesses the adjoint vector almost sequentially.
+     *
+     * The indices are numbered in the order of their first access in the reverse evaluation, see IndexRenumbering
+     * for details. The statements of the range, the adjoint vector and the index handler are updated. All active
+     * variables which still have an index of the range need to be updated with IndexRenumbering::apply afterwards,
+     * e.g. the registered inputs and outputs.
+     *
+     * The indices of the range can also be used by statements outside of the range. The new numbers are therefore
+     * applied to the whole tape. Tapes with external functions are not changed, since the external functions store
+     * their own indices.
+     *
+     * It has to hold start >= end.
+     *
+     * @param[out] renumbering  The new numbers of the indices.
+     * @param[in]        start  The start point of the range.
+     * @param[in]          end  The end point of the range.
+     */
+    void renumberIndices(IndexRenumberingType& renumbering, const Position& start, const Position& end) {
+      renumbering.begin(indexHandler.getMaximumGlobalIndex());
+
+      const Position tapeStart = getPosition();
+      const Position tapeEnd = getZeroPosition();
+
+      if(tapeStart.chunk == tapeEnd.chunk && tapeStart.data == tapeEnd.data) {
+        auto analyzeFunc = [] (IndexRenumberingType& renumbering,
+            size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+            size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+            size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &numberOfArguments, Index* lhsIndices) {
+          CODI_UNUSED(endDataPos);
+          CODI_UNUSED(endUnitPos);
+          CODI_UNUSED(jacobies);
+
+          while(stmtPos > endStmtPos) {
+            --stmtPos;
+            renumbering.addIndex(lhsIndices[stmtPos]);
+
+            for(StatementInt curVar = 0; curVar < getJacobiCount(numberOfArguments[stmtPos]); ++curVar) {
+              --dataPos;
+              renumbering.addIndex(indices[dataPos]);
+            }
+            for(StatementInt curVar = 0; curVar < getUnitCount(numberOfArguments[stmtPos]); ++curVar) {
+              --unitPos;
+              renumbering.addIndex(units[unitPos] >> UnitJacobiTagBits);
+            }
+          }
+        };
+
+        jacobiVector.evaluateReverse(start.inner, end.inner, analyzeFunc, renumbering);
+      }
+
+      renumbering.finalize();
+
+      if(0 != renumbering.getIndexCount()) {
+        auto stmtFunc = [&renumbering] (JacobiStatementInt* numberOfArguments, Index* lhsIndex) {
+          CODI_UNUSED(numberOfArguments);
+
+          renumbering.apply(*lhsIndex);
+        };
+        stmtVector.modifyEachReverse(getStmtPosition(tapeStart.inner.inner), getStmtPosition(tapeEnd.inner.inner), stmtFunc);
+
+        auto jacobiFunc = [&renumbering] (JacobiDataPointer jacobi, JacobiIndexPointer index) {
+          CODI_UNUSED(jacobi);
+
+          renumbering.apply(index[0]);
+        };
+        jacobiVector.modifyEachReverse(tapeStart.inner, tapeEnd.inner, jacobiFunc);
+
+        if(ImplicitUnitJacobies) {
+          // the new index can only exceed the shifted range if the range contains indices that could not be shifted
+          auto unitFunc = [&renumbering] (UnitIndexPointer unit) {
+            const Index newIndex = renumbering.getNewIndex(unit[0] >> UnitJacobiTagBits);
+            codiAssert(newIndex <= (std::numeric_limits<Index>::max() >> UnitJacobiTagBits));
+
+            unit[0] = (newIndex << UnitJacobiTagBits) | (unit[0] & UnitJacobiMinusOne);
+          };
+          unitVector.modifyEachReverse(tapeStart.inner.inner, tapeEnd.inner.inner, unitFunc);
+        }
+
+        if(NULL != adjoints) {
+          resizeAdjointsToIndexSize();
+          renumbering.permute(adjoints, adjointsSize);
+        }
+        // the marked adjoint values have been moved
+        dirtyAdjoints.addAll();
+
+        indexHandler.renumberIndices(renumbering);
+      }
+    }
+
+    /**
+     * @brief Move the live indices into a dense range and shrink the index handler and the vectors which are addressed by the indices.
+     *
+     * After a peak in the number of live indices, the index handler, the adjoint vector keep their size. The
+     * compaction renumbers the live indices densely, see IndexCompaction for details, and releases the memory of
+     * the removed indices. The adjoint values of the live indices are kept. All active variables need to be updated
+     * with IndexCompaction::apply afterwards.
+     *
+     * The tape needs to be empty, e.g. after a reset, since the recorded indices would become invalid. The index
+     * handler needs to count the use of the indices, e.g. ReuseIndexHandlerUseCount.
+     *
+     * @param[out] compaction  The new numbers of the indices.
+     */
+    void compactIndices(IndexCompactionType& compaction) {
+      if(getZeroPosition() != getPosition()) {
+        CODI_EXCEPTION("The indices can only be compacted if the tape is empty.");
+      }
+
+      indexHandler.compactIndices(compaction);
+      Index indexEnd = compaction.getIndexEnd();
+
+      if(NULL != adjoints) {
+        compaction.compact(adjoints, adjointsSize);
+        resizeAdjoints(std::min(adjointsSize, indexEnd + 1));
+        ZeroPageArray<GradientValue>::zero(adjoints, std::min((size_t)indexEnd, (size_t)adjointsSize), adjointsSize);
+      }
+      // the marked adjoint values have been moved
+      dirtyAdjoints.addAll();
+    }
+
+    /**
+     * @brief Eliminate the intermediate variables of the range from start to the current position.
+     *
+     * The statements of the range are replaced by the statements of the remaining variables, see VertexElimination
+     * for details. The variables which are used after the range need to be added to the elimination with
+     * VertexElimination::addOutput beforehand. The remaining statements keep their indices. The adjoint values of
+     * the range are cleared.
+     *
+     * Ranges with external functions are not changed.
+     *
+     * @param[in,out] elimination  The outputs of the range.
+     * @param[in]           start  The start point of the range.
+     */
+    void eliminateIntermediates(VertexEliminationType& elimination, const Position& start) {
+      const Position end = getPosition();
+      elimination.begin(indexHandler.getMaximumGlobalIndex());
+
+      if(start.chunk != end.chunk || start.data != end.data) {
+        return;
+      }
+
+      auto analyzeFunc = [this] (VertexEliminationType& elimination,
+          size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+          size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+          size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &numberOfArguments, Index* lhsIndices) {
+        CODI_UNUSED(endDataPos);
+        CODI_UNUSED(endUnitPos);
+
+        while(stmtPos > endStmtPos) {
+          --stmtPos;
+          elimination.addStatement(lhsIndices[stmtPos], false);
+
+          for(StatementInt curVar = 0; curVar < getJacobiCount(numberOfArguments[stmtPos]); ++curVar) {
+            --dataPos;
+            elimination.addArgument(indices[dataPos], jacobies[dataPos]);
+          }
+          for(StatementInt curVar = 0; curVar < getUnitCount(numberOfArguments[stmtPos]); ++curVar) {
+            --unitPos;
+            elimination.addArgument(units[unitPos] >> UnitJacobiTagBits,
+                                    (UnitJacobiMinusOne & units[unitPos]) ? Real(-1.0) : Real(1.0));
+          }
+        }
+      };
+      jacobiVector.evaluateReverse(end.inner, start.inner, analyzeFunc, elimination);
+
+      elimination.finalize(Index(), false);
+
+      reset(start);
+
+      size_t argPos = 0;
+      for(size_t stmt = 0; stmt < elimination.statements.size(); ++stmt) {
+        const StatementInt size = elimination.statements[stmt];
+
+        stmtVector.reserveItems(1);
+        reserveJacobiEntries(size);
+
+        const size_t startSize = jacobiVector.getChunkPosition();
+        const size_t startUnitSize = getUnitChunkPosition();
+        for(StatementInt curVar = 0; curVar < size; ++curVar, ++argPos) {
+          pushArgument(elimination.jacobies[argPos], elimination.argumentIndices[argPos]);
+        }
+        pushStmtData(createJacobiStatement((StatementInt)(jacobiVector.getChunkPosition() - startSize),
+                                           (StatementInt)(getUnitChunkPosition() - startUnitSize)),
+                     elimination.lhsIndices[stmt]);
+      }
+    }
+
   private:
 
     /**
@@ -299,10 +570,10 @@ namespace codi {
      * The method is called by the statement module to push the
      * statements on the tape.
      *
-     * @param[in] numberOfArguments  The number of arguments in the statements that have been pushed as jacobies.
+     * @param[in] numberOfArguments  The number of arguments in the statements that have been pushed as jacobies and unit arguments.
      * @param[in]          lhsIndex  The index of the lhs value of the operation.
      */
-    CODI_INLINE void pushStmtData(const StatementInt& numberOfArguments, const Index& lhsIndex) {
+    CODI_INLINE void pushStmtData(const JacobiStatementInt& numberOfArguments, const Index& lhsIndex) {
       stmtVector.setDataAndMove(numberOfArguments, lhsIndex);
     }
 
@@ -316,6 +587,9 @@ namespace codi {
      * @param[in]           endDataPos The end position in the jacobi and index vector.
      * @param[in]             jacobies The pointer to the jacobies of the rhs arguments.
      * @param[in]              indices The pointer the indices of the rhs arguments.
+     * @param[in,out]          unitPos The current position in the unit vector. This value is used in the next invocation of this method.
+     * @param[in]           endUnitPos The end position in the unit vector.
+     * @param[in]                units The pointer to the indices of the unit arguments.
      * @param[in,out]          stmtPos The starting point in the expression evaluation. The index is decremented.
      * @param[in]           endStmtPos The ending point in the expression evaluation.
      * @param[in]    numberOfArguments The pointer to the number of arguments of the statement.
@@ -325,14 +599,20 @@ namespace codi {
      */
     template<typename AdjointData>
     CODI_INLINE void evaluateStackReverse(AdjointData* adjointData,
-                                          size_t& dataPos, const size_t& endDataPos, Real* &jacobies, Index* &indices,
-                                          size_t& stmtPos, const size_t& endStmtPos, StatementInt* &numberOfArguments,
+                                          size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+                                          size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+                                          size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &numberOfArguments,
                                           Index* lhsIndices) {
 
-      CODI_UNUSED(endDataPos);
+      size_t prefetchPos = dataPos;
+      size_t prefetchUnitPos = unitPos;
 
       while(stmtPos > endStmtPos) {
         --stmtPos;
+        if(0 != PrefetchDistance && stmtPos >= endStmtPos + PrefetchDistance) {
+          CODI_PREFETCH(&adjointData[lhsIndices[stmtPos - PrefetchDistance]]);
+        }
+
         const Index& lhsIndex = lhsIndices[stmtPos];
         const AdjointData adj = adjointData[lhsIndex];
         adjointData[lhsIndex] = GradientValue();
@@ -341,7 +621,11 @@ namespace codi {
         handleReverseEval(adj, lhsIndex);
 #endif
 
-        incrementAdjoints(adj, adjointData, numberOfArguments[stmtPos], dataPos, jacobies, indices);
+        prefetchAdjointsReverse(adjointData, indices, prefetchPos, dataPos, endDataPos);
+        if(ImplicitUnitJacobies) {
+          prefetchAdjointsReverse(adjointData, units, prefetchUnitPos, unitPos, endUnitPos, (int)UnitJacobiTagBits);
+        }
+        incrementAdjoints(adj, adjointData, numberOfArguments[stmtPos], dataPos, jacobies, indices, unitPos, units);
       }
     }
 
@@ -360,9 +644,10 @@ namespace codi {
     CODI_INLINE void evaluateInt(const Position& start, const Position& end, AdjointData* adjointData) {
 
       auto evalFunc = [this] (AdjointData* adjointData,
-          size_t& dataPos, const size_t& endDataPos, Real* &jacobies, Index* &indices,
-          size_t& stmtPos, const size_t& endStmtPos, StatementInt* &statements, Index* lhsIndices) {
-        evaluateStackReverse<AdjointData>(adjointData, dataPos, endDataPos, jacobies, indices,
+          size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+          size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+          size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &statements, Index* lhsIndices) {
+        evaluateStackReverse<AdjointData>(adjointData, dataPos, endDataPos, jacobies, indices, unitPos, endUnitPos, units,
                                       stmtPos, endStmtPos, statements, lhsIndices);
       };
       auto reverseFunc = &JacobiVector::template evaluateReverse<decltype(evalFunc), AdjointData*&>;
@@ -372,6 +657,66 @@ namespace codi {
       evaluateExtFunc(start, end, reverseFunc, jacobiVector, &interface, evalFunc, adjointData);
     }
 
+    /**
+     * @brief Implementation of the AD stack evaluation for a block adjoint.
+     *
+     * The arguments are the same as for evaluateStackReverse.
+     *
+     * @param[in,out]           block  The block with the adjoint variables.
+     * @param[in,out]         dataPos  The current position in the jacobi and index vector. This value is used in the next invocation of this method..
+     * @param[in]          endDataPos  The end position in the jacobi and index vector.
+     * @param[in]            jacobies  The pointer to the jacobies of the rhs arguments.
+     * @param[in]             indices  The pointer the indices of the rhs arguments.
+     * @param[in,out]          unitPos The current position in the unit vector. This value is used in the next invocation of this method.
+     * @param[in]           endUnitPos The end position in the unit vector.
+     * @param[in]                units The pointer to the indices of the unit arguments.
+     * @param[in,out]         stmtPos  The starting point in the expression evaluation. The index is decremented.
+     * @param[in]          endStmtPos  The ending point in the expression evaluation.
+     * @param[in]   numberOfArguments  The pointer to the number of arguments of the statement.
+     * @param[in]          lhsIndices  The pointer the indices of the lhs.
+     */
+    CODI_INLINE void evaluateStackReverseBlock(BlockAdjoint<Real>* block,
+                                               size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+                                               size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+                                               size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &numberOfArguments,
+                                               Index* lhsIndices) {
+
+      CODI_UNUSED(endDataPos);
+      CODI_UNUSED(endUnitPos);
+
+      while(stmtPos > endStmtPos) {
+        --stmtPos;
+        const Real* adj = block->loadLhs(lhsIndices[stmtPos], true);
+
+        incrementAdjointsBlock(adj, block, numberOfArguments[stmtPos], dataPos, jacobies, indices, unitPos, units);
+      }
+    }
+
+    /**
+     * @brief Evaluate the stack in reverse order for all directions of a block adjoint.
+     *
+     * It has to hold start >= end.
+     *
+     * @param[in]     start  The start point for the evaluation.
+     * @param[in]       end  The end point for the evaluation.
+     * @param[in,out] block  The block with the adjoint variables.
+     */
+    CODI_INLINE void evaluateInt(const Position& start, const Position& end, BlockAdjoint<Real>* block) {
+
+      auto evalFunc = [this] (BlockAdjoint<Real>* block,
+          size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+          size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+          size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &statements, Index* lhsIndices) {
+        evaluateStackReverseBlock(block, dataPos, endDataPos, jacobies, indices, unitPos, endUnitPos, units,
+                                  stmtPos, endStmtPos, statements, lhsIndices);
+      };
+      auto reverseFunc = &JacobiVector::template evaluateReverse<decltype(evalFunc), BlockAdjoint<Real>*&>;
+
+      AdjointInterfaceImpl<Real, BlockAdjoint<Real> > interface(block);
+
+      evaluateExtFunc(start, end, reverseFunc, jacobiVector, &interface, evalFunc, block);
+    }
+
     /**
      * @brief Implementation of the AD stack evaluation.
      *
@@ -382,6 +727,9 @@ namespace codi {
      * @param[in]           endDataPos The end position in the jacobi and index vector.
      * @param[in]             jacobies The pointer to the jacobies of the rhs arguments.
      * @param[in]              indices The pointer the indices of the rhs arguments.
+     * @param[in,out]          unitPos The current position in the unit vector. This value is used in the next invocation of this method.
+     * @param[in]           endUnitPos The end position in the unit vector.
+     * @param[in]                units The pointer to the indices of the unit arguments.
      * @param[in,out]          stmtPos The starting point in the expression evaluation. The index is decremented.
      * @param[in]           endStmtPos The ending point in the expression evaluation.
      * @param[in]    numberOfArguments The pointer to the number of arguments of the statement.
@@ -391,16 +739,18 @@ namespace codi {
      */
     template<typename AdjointData>
     CODI_INLINE void evaluateStackForward(AdjointData* adjointData,
-                                          size_t& dataPos, const size_t& endDataPos, Real* &jacobies, Index* &indices,
-                                          size_t& stmtPos, const size_t& endStmtPos, StatementInt* &numberOfArguments,
+                                          size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+                                          size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+                                          size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &numberOfArguments,
                                           Index* lhsIndices) {
       CODI_UNUSED(endDataPos);
+      CODI_UNUSED(endUnitPos);
 
       while(stmtPos < endStmtPos) {
         const Index& lhsIndex = lhsIndices[stmtPos];
         AdjointData adj = AdjointData();
 
-        incrementTangents(adj, adjointData, numberOfArguments[stmtPos], dataPos, jacobies, indices);
+        incrementTangents(adj, adjointData, numberOfArguments[stmtPos], dataPos, jacobies, indices, unitPos, units);
         adjointData[lhsIndex] = adj;
 
         ++stmtPos;
@@ -422,9 +772,10 @@ namespace codi {
     CODI_INLINE void evaluateForwardInt(const Position& start, const Position& end, AdjointData* adjointData) {
 
       auto evalFunc = [this] (AdjointData* adjointData,
-          size_t& dataPos, const size_t& endDataPos, Real* &jacobies, Index* &indices,
-          size_t& stmtPos, const size_t& endStmtPos, StatementInt* &statements, Index* lhsIndices) {
-        evaluateStackForward<AdjointData>(adjointData, dataPos, endDataPos, jacobies, indices,
+          size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+          size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+          size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &statements, Index* lhsIndices) {
+        evaluateStackForward<AdjointData>(adjointData, dataPos, endDataPos, jacobies, indices, unitPos, endUnitPos, units,
                                       stmtPos, endStmtPos, statements, lhsIndices);
       };
       auto forwardFunc = &JacobiVector::template evaluateForward<decltype(evalFunc), AdjointData*&>;
@@ -493,6 +844,6 @@ namespace codi {
    * @brief The instantiation of the index manager for the jacobi index tapes.
    */
   template <typename TapeTypes>
-  typename TapeTypes::IndexHandler JacobiIndexTape<TapeTypes>::indexHandler(0);
+  CODI_TAPE_STORAGE typename TapeTypes::IndexHandler JacobiIndexTape<TapeTypes>::indexHandler(0);
 
 }
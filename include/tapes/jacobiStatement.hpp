@@ -0,0 +1,140 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#pragma once
+
+#include <type_traits>
+
+#include "../configure.h"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief The statement data of the Jacobi tapes if ImplicitUnitJacobies is enabled.
+   *
+   * The arguments of a statement are split into the arguments with a stored jacobi and the arguments with the
+   * jacobies 1.0 and -1.0. The latter are stored without a jacobi in a separate index vector of the tape.
+   */
+  struct UnitJacobiStatement {
+    StatementInt jacobies; /**< The number of arguments with a stored jacobi or StatementIntInputTag for inputs. */
+    StatementInt units;    /**< The number of arguments with the jacobi 1.0 or -1.0. */
+  };
+
+  /**
+   * @brief The data that the Jacobi tapes store for each statement.
+   *
+   * StatementInt holds the number of arguments. UnitJacobiStatement is used if ImplicitUnitJacobies is enabled.
+   */
+  typedef std::conditional<ImplicitUnitJacobies, UnitJacobiStatement, StatementInt>::type JacobiStatementInt;
+
+  /**
+   * @brief Get the number of arguments with a stored jacobi.
+   *
+   * @param[in] statement  The data of the statement.
+   * @return The number of arguments or StatementIntInputTag for inputs.
+   */
+  CODI_INLINE StatementInt getJacobiCount(const StatementInt& statement) {
+    return statement;
+  }
+
+  /**
+   * @brief Get the number of arguments with a stored jacobi.
+   *
+   * @param[in] statement  The data of the statement.
+   * @return The number of arguments or StatementIntInputTag for inputs.
+   */
+  CODI_INLINE StatementInt getJacobiCount(const UnitJacobiStatement& statement) {
+    return statement.jacobies;
+  }
+
+  /**
+   * @brief Get the number of arguments with the jacobi 1.0 or -1.0.
+   *
+   * @param[in] statement  The data of the statement.
+   * @return Always zero, the arguments are not split.
+   */
+  CODI_INLINE StatementInt getUnitCount(const StatementInt& statement) {
+    CODI_UNUSED(statement);
+
+    return 0;
+  }
+
+  /**
+   * @brief Get the number of arguments with the jacobi 1.0 or -1.0.
+   *
+   * @param[in] statement  The data of the statement.
+   * @return The number of arguments in the unit index vector.
+   */
+  CODI_INLINE StatementInt getUnitCount(const UnitJacobiStatement& statement) {
+    return statement.units;
+  }
+
+  /**
+   * @brief Check if the statement was created by the registration of an input.
+   *
+   * @param[in] statement  The data of the statement.
+   * @return true if the statement has no arguments and is an input.
+   *
+   * @tparam Statement  StatementInt or UnitJacobiStatement.
+   */
+  template<typename Statement>
+  CODI_INLINE bool isInputStatement(const Statement& statement) {
+    return StatementIntInputTag == getJacobiCount(statement);
+  }
+
+#ifndef DOXYGEN_DISABLE
+  CODI_INLINE StatementInt createJacobiStatement(const StatementInt& jacobies, const StatementInt& units, std::false_type) {
+    codiAssert(0 == units);
+    CODI_UNUSED(units);
+
+    return jacobies;
+  }
+
+  CODI_INLINE UnitJacobiStatement createJacobiStatement(const StatementInt& jacobies, const StatementInt& units, std::true_type) {
+    UnitJacobiStatement statement;
+    statement.jacobies = jacobies;
+    statement.units = units;
+
+    return statement;
+  }
+#endif
+
+  /**
+   * @brief Create the data of a statement.
+   *
+   * @param[in] jacobies  The number of arguments with a stored jacobi or StatementIntInputTag for inputs.
+   * @param[in]    units  The number of arguments with the jacobi 1.0 or -1.0. Needs to be zero if ImplicitUnitJacobies
+   *                      is disabled.
+   * @return The data for the statement vector.
+   */
+  CODI_INLINE JacobiStatementInt createJacobiStatement(const StatementInt& jacobies, const StatementInt& units) {
+    return createJacobiStatement(jacobies, units, std::integral_constant<bool, ImplicitUnitJacobies>());
+  }
+}
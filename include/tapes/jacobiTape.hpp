@@ -31,16 +31,27 @@
 #include <iostream>
 #include <iomanip>
 #include <cstddef>
+#include <limits>
 #include <tuple>
+#include <type_traits>
 
 #include "../activeReal.hpp"
 #include "../typeFunctions.hpp"
 #include "chunk.hpp"
 #include "chunkVector.hpp"
+#include "adjointBlockSummary.hpp"
+#include "adjointPageWindow.hpp"
+#include "dirtyAdjointRange.hpp"
 #include "externalFunctions.hpp"
+#include "jacobiStatement.hpp"
+#include "levelSchedule.hpp"
+#include "passThroughChunkVector.hpp"
 #include "reverseTapeInterface.hpp"
 #include "singleChunkVector.hpp"
+#include "vertexElimination.hpp"
+#include "zeroPageArray.hpp"
 #include "../tapeTypes.hpp"
+#include "../tools/blockAdjoint.hpp"
 #include "../tools/tapeValues.hpp"
 
 /**
@@ -67,14 +78,21 @@ namespace codi {
     typedef RTT BaseTypes;
 
     /** @brief The data for each statement. */
-    typedef Chunk1<StatementInt> StatementChunk;
+    typedef Chunk1<JacobiStatementInt> StatementChunk;
     /** @brief The chunk vector for the statement data. */
     typedef DataVector<StatementChunk, IndexHandler> StatementVector;
 
+    /** @brief The data for the arguments with the jacobies 1.0 and -1.0, see ImplicitUnitJacobies. */
+    typedef Chunk1<typename IndexHandler::Index> UnitChunk;
+    /** @brief The chunk vector for the unit arguments. Without ImplicitUnitJacobies it passes through to the statements. */
+    typedef typename std::conditional<ImplicitUnitJacobies,
+                                      DataVector<UnitChunk, StatementVector>,
+                                      PassThroughChunkVector<UnitChunk, StatementVector> >::type UnitVector;
+
     /** @brief The data for the jacobies of each statement */
     typedef Chunk2< Real, typename IndexHandler::Index> JacobiChunk;
     /** @brief The chunk vector for the jacobi data. */
-    typedef DataVector<JacobiChunk, StatementVector> JacobiVector;
+    typedef DataVector<JacobiChunk, UnitVector> JacobiVector;
 
     /** @brief The data for the external functions. */
     typedef Chunk2<ExternalFunction,typename JacobiVector::Position> ExternalFunctionChunk;
@@ -100,6 +118,8 @@ namespace codi {
    *
    * externalFunctions -> jacobiData -> statements -> indexHandler
    *
+   * If ImplicitUnitJacobies is enabled, the unit data is nested between the jacobi data and the statements.
+   *
    * The size of the tape can be set with the resize function,
    * the tape will allocate enough chunks such that the given data requirements will fit into the chunks.
    *
@@ -126,6 +146,18 @@ namespace codi {
     /** @brief This tape requires no primal value handling. */
     static const bool RequiresPrimalReset = false;
 
+    /** @brief The evaluation only reads the tape if the chunks can be read concurrently, see ChunkInterface::ConcurrentRead. */
+    static const bool AllowConcurrentEvaluation = TapeTypes::StatementVector::ChunkType::ConcurrentRead &&
+                                                   TapeTypes::UnitVector::ChunkType::ConcurrentRead &&
+                                                   TapeTypes::JacobiVector::ChunkType::ConcurrentRead &&
+                                                   TapeTypes::ExternalFunctionVector::ChunkType::ConcurrentRead;
+
+    /** @brief The schedule for the parallel reverse evaluation, see createLevelSchedule. */
+    typedef LevelSchedule<Real, Index, typename TapeTypes::Position> LevelScheduleType;
+
+    /** @brief The elimination of intermediate variables in a tape range, see eliminateIntermediates. */
+    typedef VertexElimination<Real, Index> VertexEliminationType;
+
     // The class name of the tape. Required by the modules.
     #define TAPE_NAME JacobiTape
 
@@ -143,6 +175,7 @@ namespace codi {
     #include "modules/statementModule.tpp"
 
     #define CHILD_VECTOR_TYPE StmtVector
+    #define UNIT_VECTOR_TYPE typename TapeTypes::UnitVector
     #define VECTOR_TYPE typename TapeTypes::JacobiVector
     #include "modules/jacobiModule.tpp"
 
@@ -156,6 +189,11 @@ namespace codi {
 
     #undef TAPE_NAME
 
+  private:
+
+    /** @brief The blocks of the adjoint vector which can be nonzero during a reverse evaluation, see SkipZeroAdjointChunks. */
+    AdjointBlockSummary<Index> nonZeroAdjointBlocks;
+
   public:
     /**
      * @brief Creates a tape with the default chunk sizes for the data, statements and
@@ -165,10 +203,13 @@ namespace codi {
       indexHandler(0),
       /* defined in tapeBaseModule */adjoints(NULL),
       /* defined in tapeBaseModule */adjointsSize(0),
+      /* defined in tapeBaseModule */dirtyAdjoints(),
       /* defined in tapeBaseModule */active(false),
       /* defined in statementModule */stmtVector(DefaultChunkSize, &indexHandler),
-      /* defined in jacobiModule */jacobiVector(DefaultChunkSize, &stmtVector),
-      /* defined in externalFunctionsModule */extFuncVector(1000, &jacobiVector) {
+      /* defined in jacobiModule */unitVector(DefaultChunkSize, &stmtVector),
+      /* defined in jacobiModule */jacobiVector(DefaultChunkSize, &unitVector),
+      /* defined in externalFunctionsModule */extFuncVector(1000, &jacobiVector),
+      nonZeroAdjointBlocks() {
     }
 
     /** @brief Tear down the tape. Delete all values from the modules */
@@ -236,14 +277,58 @@ namespace codi {
      * @param[in]   end  The ending position for the reset of the vector.
      */
     CODI_INLINE void clearAdjoints(const Position& start, const Position& end){
-      Index startPos = min(end.inner.inner.inner, adjointsSize - 1);
-      Index endPos = min(start.inner.inner.inner, adjointsSize - 1);
+      Index startPos = min((Index)(getStmtPosition(end.inner.inner).inner + 1), adjointsSize);
+      Index endPos = min((Index)(getStmtPosition(start.inner.inner).inner + 1), adjointsSize);
 
-      for(Index i = startPos + 1; i <= endPos; ++i) {
+      for(Index i = startPos; i < endPos; ++i) {
         adjoints[i] = GradientValue();
       }
     }
 
+    /**
+     * @brief Call the function for each index of the adjoint vector that an evaluation of the range accesses.
+     *
+     * The function is called for the left hand side and the arguments of all statements in the range. An index can
+     * be reported several times. Ranges with external functions are not inspected, since the external functions
+     * can access arbitrary adjoint values.
+     *
+     * It has to hold start >= end.
+     *
+     * @param[in]    start  The start of the range.
+     * @param[in]      end  The end of the range.
+     * @param[in,out] func  The function which is called with each index.
+     *
+     * @return false if the range contains external functions. The function is not called in this case.
+     *
+     * @tparam Func  Needs to be callable with an Index.
+     */
+    template<typename Func>
+    bool forEachAdjointIndex(const Position& start, const Position& end, Func& func) {
+      if(start.chunk != end.chunk || start.data != end.data) {
+        return false;
+      }
+
+      for(Index index = getStmtPosition(end.inner.inner).inner + 1; index <= getStmtPosition(start.inner.inner).inner; ++index) {
+        func(index);
+      }
+
+      auto argFunc = [&func] (JacobiDataPointer jacobi, JacobiIndexPointer index) {
+        CODI_UNUSED(jacobi);
+
+        func(index[0]);
+      };
+      jacobiVector.forEachReverse(start.inner, end.inner, argFunc);
+
+      if(ImplicitUnitJacobies) {
+        auto unitFunc = [&func] (UnitIndexPointer unit) {
+          func(unit[0] >> UnitJacobiTagBits);
+        };
+        unitVector.forEachReverse(start.inner.inner, end.inner.inner, unitFunc);
+      }
+
+      return true;
+    }
+
     /**
      * @brief Get the current position of the tape.
      *
@@ -266,6 +351,148 @@ namespace codi {
       return getExtFuncZeroPosition();
     }
 
+    /**
+     * @brief Analyze the dependencies in a tape range for the parallel reverse evaluation.
+     *
+     * The statements are grouped into levels that can be evaluated in parallel, see LevelSchedule for details.
+     * The schedule can be evaluated several times with evaluateLevelSchedule as long as the tape range is not changed.
+     * Ranges with external functions are evaluated sequentially.
+     *
+     * It has to hold start >= end.
+     *
+     * @param[out] schedule  The schedule for the range.
+     * @param[in]     start  The start point for the evaluation.
+     * @param[in]       end  The end point for the evaluation.
+     */
+    void createLevelSchedule(LevelScheduleType& schedule, const Position& start, const Position& end) {
+      schedule.begin(start, end, indexHandler.getMaximumGlobalIndex());
+
+      if(start.chunk != end.chunk || start.data != end.data) {
+        schedule.setSequential();
+      } else {
+        auto analyzeFunc = [this] (const size_t& startAdjPos, const size_t& endAdjPos, LevelScheduleType& schedule,
+            size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+            size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+            size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &statements) {
+          analyzeStack(startAdjPos, endAdjPos, schedule, dataPos, endDataPos, jacobies, indices, unitPos, endUnitPos, units,
+                       stmtPos, endStmtPos, statements);
+        };
+
+        jacobiVector.evaluateReverse(start.inner, end.inner, analyzeFunc, schedule);
+
+        schedule.finalize();
+      }
+    }
+
+    /**
+     * @brief Perform the reverse evaluation of a level schedule with a custom adjoint vector.
+     *
+     * The updates of each level are distributed over the OpenMP threads, if OpenMP is enabled.
+     *
+     * @param[in]     schedule  The schedule created with createLevelSchedule.
+     * @param[in,out] adjointData  The vector of the adjoint variables.
+     *
+     * @tparam AdjointData The data for the adjoint vector it needs to support add, multiply and comparison operations.
+     */
+    template<typename AdjointData>
+    void evaluateLevelSchedule(const LevelScheduleType& schedule, AdjointData* adjointData) {
+      if(schedule.sequential) {
+        evaluate(schedule.start, schedule.end, adjointData);
+      } else {
+        schedule.evaluate(adjointData);
+      }
+    }
+
+    /**
+     * @brief Perform the reverse evaluation of a level schedule.
+     *
+     * @param[in] schedule  The schedule created with createLevelSchedule.
+     */
+    void evaluateLevelSchedule(const LevelScheduleType& schedule) {
+      resizeAdjointsToIndexSize();
+      dirtyAdjoints.addRange(*this, schedule.start, schedule.end);
+
+      evaluateLevelSchedule(schedule, adjoints);
+    }
+
+    /**
+     * @brief Eliminate the intermediate variables of the range from start to the current position.
+     *
+     * The statements of the range are replaced by the statements of the remaining variables, see VertexElimination
+     * for details. The variables which are used after the range need to be added to the elimination with
+     * VertexElimination::addOutput beforehand. The remaining statements get new indices, all active variables with
+     * an index of the range need to be updated with VertexElimination::apply afterwards, e.g. the registered inputs
+     * and outputs. The adjoint values of the range are cleared.
+     *
+     * Ranges with external functions are not changed.
+     *
+     * @param[in,out] elimination  The outputs of the range. Contains the new numbers of the indices afterwards.
+     * @param[in]           start  The start point of the range.
+     */
+    void eliminateIntermediates(VertexEliminationType& elimination, const Position& start) {
+      const Position end = getPosition();
+      elimination.begin(indexHandler.getMaximumGlobalIndex());
+
+      if(start.chunk != end.chunk || start.data != end.data) {
+        return;
+      }
+
+      auto analyzeFunc = [this] (const size_t& startAdjPos, const size_t& endAdjPos, VertexEliminationType& elimination,
+          size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+          size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+          size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &statements) {
+        CODI_UNUSED(endDataPos);
+        CODI_UNUSED(endUnitPos);
+        CODI_UNUSED(endStmtPos);
+
+        for(size_t adjPos = startAdjPos; adjPos > endAdjPos; --adjPos) {
+          --stmtPos;
+          elimination.addStatement((Index)adjPos, isInputStatement(statements[stmtPos]));
+
+          if(!isInputStatement(statements[stmtPos])) {
+            for(StatementInt curVar = 0; curVar < getJacobiCount(statements[stmtPos]); ++curVar) {
+              --dataPos;
+              elimination.addArgument(indices[dataPos], jacobies[dataPos]);
+            }
+            for(StatementInt curVar = 0; curVar < getUnitCount(statements[stmtPos]); ++curVar) {
+              --unitPos;
+              elimination.addArgument(units[unitPos] >> UnitJacobiTagBits,
+                                      (UnitJacobiMinusOne & units[unitPos]) ? Real(-1.0) : Real(1.0));
+            }
+          }
+        }
+      };
+      jacobiVector.evaluateReverse(end.inner, start.inner, analyzeFunc, elimination);
+
+      elimination.finalize(getStmtPosition(start.inner.inner).inner, true);
+
+      reset(start);
+
+      size_t argPos = 0;
+      for(size_t stmt = 0; stmt < elimination.statements.size(); ++stmt) {
+        Index lhsIndex = Index();
+        if(StatementIntInputTag == elimination.statements[stmt]) {
+          Real value = Real();
+          registerInputInternal(value, lhsIndex);
+        } else {
+          const StatementInt size = elimination.statements[stmt];
+          stmtVector.reserveItems(1);
+          reserveJacobiEntries(size);
+
+          const size_t startSize = jacobiVector.getChunkPosition();
+          const size_t startUnitSize = getUnitChunkPosition();
+          for(StatementInt curVar = 0; curVar < size; ++curVar, ++argPos) {
+            pushArgument(elimination.jacobies[argPos], elimination.argumentIndices[argPos]);
+          }
+
+          indexHandler.assignIndex(lhsIndex);
+          pushStmtData(createJacobiStatement((StatementInt)(jacobiVector.getChunkPosition() - startSize),
+                                             (StatementInt)(getUnitChunkPosition() - startUnitSize)), lhsIndex);
+        }
+        codiAssert(lhsIndex == elimination.lhsIndices[stmt]);
+      }
+    }
+
 
   private:
 
@@ -275,13 +502,13 @@ namespace codi {
      * The method is called by the statement module to push the
      * statements on the tape.
      *
-     * @param[in] numberOfArguments  The number of arguments in the statements that have been pushed as jacobies.
-     * @param[in]          lhsIndex  The index of the lhs value of the operation.
+     * @param[in] statement  The number of arguments in the statements that have been pushed as jacobies and unit arguments.
+     * @param[in]  lhsIndex  The index of the lhs value of the operation.
      */
-    CODI_INLINE void pushStmtData(const StatementInt& numberOfArguments, const Index& lhsIndex) {
+    CODI_INLINE void pushStmtData(const JacobiStatementInt& statement, const Index& lhsIndex) {
       CODI_UNUSED(lhsIndex);
 
-      stmtVector.setDataAndMove(numberOfArguments);
+      stmtVector.setDataAndMove(statement);
     }
 
     /**
@@ -296,44 +523,152 @@ namespace codi {
      * @param[in]      endDataPos  The end position in the jacobi and index vector.
      * @param[in]        jacobies  The pointer to the jacobi vector.
      * @param[in]         indices  The pointer to the index vector
+     * @param[in,out]     unitPos  The current position in the unit vector. This value is used in the next invocation of this method.
+     * @param[in]      endUnitPos  The end position in the unit vector.
+     * @param[in]           units  The pointer to the unit vector.
      * @param[in,out]     stmtPos  The current position in the statement vector. This value is used in the next invocation of this method.
      * @param[in]      endStmtPos  The end position in the statement vector.
      * @param[in]      statements  The pointer to the statement vector.
+     * @param[in]      markBlocks  If the arguments of the statements are marked in nonZeroAdjointBlocks.
+     * @param[in,out]      window  The window which releases the adjoint pages. NULL if no pages are released.
      *
      * @tparam AdjointData The data for the adjoint vector it needs to support add, multiply and comparison operations.
      */
     template<typename AdjointData>
     CODI_INLINE void evaluateStackReverse(const size_t& startAdjPos, const size_t& endAdjPos, AdjointData* adjointData,
-                                      size_t& dataPos, const size_t& endDataPos, Real* &jacobies, Index* &indices,
-                                      size_t& stmtPos, const size_t& endStmtPos, StatementInt* &statements) {
+                                      size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+                                      size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+                                      size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &statements, const bool markBlocks,
+                                      AdjointPageWindow<GradientValue>* window) {
 
-      CODI_UNUSED(endDataPos);
       CODI_UNUSED(endStmtPos);
 
       size_t adjPos = startAdjPos;
+      size_t prefetchPos = dataPos;
+      size_t prefetchUnitPos = unitPos;
 
       while(adjPos > endAdjPos) {
         --stmtPos;
 
         const AdjointData adj = adjointData[adjPos];
-        if(ZeroAdjointReverse && StatementIntInputTag != statements[stmtPos]) {
+        if(ZeroAdjointReverse && !isInputStatement(statements[stmtPos])) {
           adjointData[adjPos] = AdjointData();
         }
         --adjPos;
 
+        if(AdjointPageWindow<GradientValue>::Enabled && NULL != window) {
+          window->evaluated(adjPos + 1, isInputStatement(statements[stmtPos]));
+        }
+
 #if CODI_AdjointHandle_Jacobi_Reverse
         handleReverseEval(adj, adjPos + 1);
 #endif
 
-        if(StatementIntInputTag != statements[stmtPos]) {
-          incrementAdjoints(adj, adjointData, statements[stmtPos], dataPos, jacobies, indices);
+        if(!isInputStatement(statements[stmtPos])) {
+          if(SkipZeroAdjointChunks && markBlocks && !isTotalZero(adj)) {
+            for(size_t argPos = dataPos - getJacobiCount(statements[stmtPos]); argPos < dataPos; ++argPos) {
+              nonZeroAdjointBlocks.mark(indices[argPos]);
+            }
+            for(size_t argPos = unitPos - getUnitCount(statements[stmtPos]); argPos < unitPos; ++argPos) {
+              nonZeroAdjointBlocks.mark(units[argPos] >> UnitJacobiTagBits);
+            }
+          }
+          prefetchAdjointsReverse(adjointData, indices, prefetchPos, dataPos, endDataPos);
+          if(ImplicitUnitJacobies) {
+            prefetchAdjointsReverse(adjointData, units, prefetchUnitPos, unitPos, endUnitPos, (int)UnitJacobiTagBits);
+          }
+          incrementAdjoints(adj, adjointData, statements[stmtPos], dataPos, jacobies, indices, unitPos, units);
         }
       }
     }
 
+    /**
+     * @brief Add the statements of the range to the level schedule.
+     *
+     * It has to hold startAdjPos >= endAdjPos. The arguments are the same as for evaluateStackReverse.
+     *
+     * @param[in]     startAdjPos  The starting point in the expression evaluation.
+     * @param[in]       endAdjPos  The ending point in the expression evaluation.
+     * @param[in,out]    schedule  The schedule for the analysis.
+     * @param[in,out]     dataPos  The current position in the jacobi and index vector. This value is used in the next invocation of this method.
+     * @param[in]      endDataPos  The end position in the jacobi and index vector.
+     * @param[in]        jacobies  The pointer to the jacobi vector.
+     * @param[in]         indices  The pointer to the index vector
+     * @param[in,out]     unitPos  The current position in the unit vector. This value is used in the next invocation of this method.
+     * @param[in]      endUnitPos  The end position in the unit vector.
+     * @param[in]           units  The pointer to the unit vector.
+     * @param[in,out]     stmtPos  The current position in the statement vector. This value is used in the next invocation of this method.
+     * @param[in]      endStmtPos  The end position in the statement vector.
+     * @param[in]      statements  The pointer to the statement vector.
+     */
+    void analyzeStack(const size_t& startAdjPos, const size_t& endAdjPos, LevelScheduleType& schedule,
+                      size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+                      size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+                      size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &statements) {
+      CODI_UNUSED(endDataPos);
+      CODI_UNUSED(endUnitPos);
+      CODI_UNUSED(endStmtPos);
+
+      size_t adjPos = startAdjPos;
+
+      while(adjPos > endAdjPos) {
+        --stmtPos;
+
+        if(!isInputStatement(statements[stmtPos])) {
+          const Index lhsIndex = (Index)adjPos;
+          schedule.addResetIndex(lhsIndex);
+
+          for(StatementInt curVar = 0; curVar < getJacobiCount(statements[stmtPos]); ++curVar) {
+            --dataPos;
+            schedule.addArgument(lhsIndex, indices[dataPos], jacobies[dataPos]);
+          }
+          for(StatementInt curVar = 0; curVar < getUnitCount(statements[stmtPos]); ++curVar) {
+            --unitPos;
+            schedule.addArgument(lhsIndex, units[unitPos] >> UnitJacobiTagBits,
+                                 (UnitJacobiMinusOne & units[unitPos]) ? Real(-1.0) : Real(1.0));
+          }
+        }
+
+        --adjPos;
+      }
+    }
+
+    /**
+     * @brief Prepare nonZeroAdjointBlocks for a reverse evaluation of the range.
+     *
+     * The chunks can only be skipped if the tape's own adjoint vector is evaluated, the nonzero adjoint values
+     * are known from dirtyAdjoints and the range contains no external functions.
+     *
+     * @param[in]           start  The start point for the evaluation.
+     * @param[in]             end  The end point for the evaluation.
+     * @param[in]     adjointData  The vector of the adjoint variables.
+     *
+     * @return true if the chunks of the jacobi vector can be skipped.
+     *
+     * @tparam AdjointData The data for the adjoint vector.
+     */
+    template<typename AdjointData>
+    bool prepareZeroChunkSkip(const Position& start, const Position& end, AdjointData* adjointData) {
+      Index low;
+      Index high;
+
+      if(!SkipZeroAdjointChunks || (void*)adjointData != (void*)adjoints ||
+         start.chunk != end.chunk || start.data != end.data ||
+         !dirtyAdjoints.getIndexRange(low, high)) {
+        return false;
+      }
+
+      nonZeroAdjointBlocks.reset((size_t)adjointsSize);
+      nonZeroAdjointBlocks.markRange(low, high);
+
+      return true;
+    }
+
     /**
      * @brief Evaluate the stack in reverse order.
      *
+     * If SkipZeroAdjointChunks is set, the chunks of jacobies are skipped if all their lhs adjoint values are zero.
+     *
      * It has to hold start >= end.
      *
      * @param[in]           start  The start point for the evaluation.
@@ -345,17 +680,103 @@ namespace codi {
     template<typename AdjointData>
     CODI_INLINE void evaluateInt(const Position& start, const Position& end, AdjointData* adjointData) {
 
-      auto evalFunc = [this] (const size_t& startAdjPos, const size_t& endAdjPos, AdjointData* adjointData,
-          size_t& dataPos, const size_t& endDataPos, Real* &jacobies, Index* &indices,
-          size_t& stmtPos, const size_t& endStmtPos, StatementInt* &statements) {
-        evaluateStackReverse<AdjointData>(startAdjPos, endAdjPos, adjointData, dataPos, endDataPos, jacobies, indices,
-                                          stmtPos, endStmtPos, statements);
+      const bool skipZeroChunks = prepareZeroChunkSkip(start, end, adjointData);
+
+      // the window is local to the evaluation, evaluations with other adjoint vectors do not modify the tape
+      AdjointPageWindow<GradientValue> adjointWindow(adjoints, (size_t)getStmtPosition(start.inner.inner).inner);
+      AdjointPageWindow<GradientValue>* window = NULL;
+      if(AdjointPageWindow<GradientValue>::isApplicable(adjoints, adjointData)) {
+        window = &adjointWindow;
+      }
+
+      auto evalFunc = [this, skipZeroChunks, window] (const size_t& startAdjPos, const size_t& endAdjPos, AdjointData* adjointData,
+          size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+          size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+          size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &statements) {
+        evaluateStackReverse<AdjointData>(startAdjPos, endAdjPos, adjointData, dataPos, endDataPos, jacobies, indices, unitPos, endUnitPos, units,
+                                          stmtPos, endStmtPos, statements, skipZeroChunks, window);
+      };
+
+      // the lhs indices of a chunk are the index range (end, start] of the index handler positions of its statements
+      auto skipFunc = [this, skipZeroChunks] (const UnitPosition& chunkStart, const UnitPosition& chunkEnd) {
+        return skipZeroChunks && nonZeroAdjointBlocks.isZero(getStmtPosition(chunkEnd).inner, getStmtPosition(chunkStart).inner);
       };
-      auto reverseFunc = &JacobiVector::template evaluateReverse<decltype(evalFunc), AdjointData*&>;
+      auto reverseFunc = &JacobiVector::template evaluateReverseSkip<decltype(skipFunc), decltype(evalFunc), AdjointData*&>;
 
       AdjointInterfaceImpl<Real, AdjointData> interface(adjointData);
 
-      evaluateExtFunc(start, end, reverseFunc, jacobiVector, &interface, evalFunc, adjointData);
+      evaluateExtFunc(start, end, reverseFunc, jacobiVector, &interface, skipFunc, evalFunc, adjointData);
+
+      if(NULL != window) {
+        window->finish((size_t)getStmtPosition(end.inner.inner).inner);
+      }
+    }
+
+    /**
+     * @brief Implementation of the AD stack evaluation for a block adjoint.
+     *
+     * It has to hold startAdjPos >= endAdjPos. The arguments are the same as for evaluateStackReverse.
+     *
+     * @param[in]     startAdjPos  The starting point in the expression evaluation.
+     * @param[in]       endAdjPos  The ending point in the expression evaluation.
+     * @param[in,out]       block  The block with the adjoint variables.
+     * @param[in,out]     dataPos  The current position in the jacobi and index vector. This value is used in the next invocation of this method.
+     * @param[in]      endDataPos  The end position in the jacobi and index vector.
+     * @param[in]        jacobies  The pointer to the jacobi vector.
+     * @param[in]         indices  The pointer to the index vector
+     * @param[in,out]     unitPos  The current position in the unit vector. This value is used in the next invocation of this method.
+     * @param[in]      endUnitPos  The end position in the unit vector.
+     * @param[in]           units  The pointer to the unit vector.
+     * @param[in,out]     stmtPos  The current position in the statement vector. This value is used in the next invocation of this method.
+     * @param[in]      endStmtPos  The end position in the statement vector.
+     * @param[in]      statements  The pointer to the statement vector.
+     */
+    CODI_INLINE void evaluateStackReverseBlock(const size_t& startAdjPos, const size_t& endAdjPos, BlockAdjoint<Real>* block,
+                                               size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+                                               size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+                                               size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &statements) {
+
+      CODI_UNUSED(endDataPos);
+      CODI_UNUSED(endUnitPos);
+      CODI_UNUSED(endStmtPos);
+
+      size_t adjPos = startAdjPos;
+
+      while(adjPos > endAdjPos) {
+        --stmtPos;
+
+        const Real* adj = block->loadLhs(adjPos, ZeroAdjointReverse && !isInputStatement(statements[stmtPos]));
+        --adjPos;
+
+        if(!isInputStatement(statements[stmtPos])) {
+          incrementAdjointsBlock(adj, block, statements[stmtPos], dataPos, jacobies, indices, unitPos, units);
+        }
+      }
+    }
+
+    /**
+     * @brief Evaluate the stack in reverse order for all directions of a block adjoint.
+     *
+     * It has to hold start >= end.
+     *
+     * @param[in]     start  The start point for the evaluation.
+     * @param[in]       end  The end point for the evaluation.
+     * @param[in,out] block  The block with the adjoint variables.
+     */
+    CODI_INLINE void evaluateInt(const Position& start, const Position& end, BlockAdjoint<Real>* block) {
+
+      auto evalFunc = [this] (const size_t& startAdjPos, const size_t& endAdjPos, BlockAdjoint<Real>* block,
+          size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+          size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+          size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &statements) {
+        evaluateStackReverseBlock(startAdjPos, endAdjPos, block, dataPos, endDataPos, jacobies, indices, unitPos, endUnitPos, units,
+                                  stmtPos, endStmtPos, statements);
+      };
+      auto reverseFunc = &JacobiVector::template evaluateReverse<decltype(evalFunc), BlockAdjoint<Real>*&>;
+
+      AdjointInterfaceImpl<Real, BlockAdjoint<Real> > interface(block);
+
+      evaluateExtFunc(start, end, reverseFunc, jacobiVector, &interface, evalFunc, block);
     }
 
     /**
@@ -370,6 +791,9 @@ namespace codi {
      * @param[in]      endDataPos  The end position in the jacobi and index vector.
      * @param[in]        jacobies  The pointer to the jacobi vector.
      * @param[in]         indices  The pointer to the index vector
+     * @param[in,out]     unitPos  The current position in the unit vector. This value is used in the next invocation of this method.
+     * @param[in]      endUnitPos  The end position in the unit vector.
+     * @param[in]           units  The pointer to the unit vector.
      * @param[in,out]     stmtPos  The current position in the statement vector. This value is used in the next invocation of this method.
      * @param[in]      endStmtPos  The end position in the statement vector.
      * @param[in]      statements  The pointer to the statement vector.
@@ -378,9 +802,11 @@ namespace codi {
      */
     template<typename AdjointData>
     CODI_INLINE void evaluateStackForward(const size_t& startAdjPos, const size_t& endAdjPos, AdjointData* adjointData,
-                                          size_t& dataPos, const size_t& endDataPos, Real* &jacobies, Index* &indices,
-                                          size_t& stmtPos, const size_t& endStmtPos, StatementInt* &statements) {
+                                          size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+                                          size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+                                          size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &statements) {
       CODI_UNUSED(endDataPos);
+      CODI_UNUSED(endUnitPos);
       CODI_UNUSED(endStmtPos);
 
       size_t adjPos = startAdjPos;
@@ -389,7 +815,7 @@ namespace codi {
         ++adjPos;
         AdjointData adj = AdjointData();
 
-        incrementTangents(adj, adjointData, statements[stmtPos], dataPos, jacobies, indices);
+        incrementTangents(adj, adjointData, statements[stmtPos], dataPos, jacobies, indices, unitPos, units);
         adjointData[adjPos] = adj;
 
         ++stmtPos;
@@ -411,9 +837,10 @@ namespace codi {
     CODI_INLINE void evaluateForwardInt(const Position& start, const Position& end, AdjointData* adjointData) {
 
       auto evalFunc = [this] (const size_t& startAdjPos, const size_t& endAdjPos, AdjointData* adjointData,
-          size_t& dataPos, const size_t& endDataPos, Real* &jacobies, Index* &indices,
-          size_t& stmtPos, const size_t& endStmtPos, StatementInt* &statements) {
-        evaluateStackForward<AdjointData>(startAdjPos, endAdjPos, adjointData, dataPos, endDataPos, jacobies, indices,
+          size_t& dataPos, const size_t& endDataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices,
+          size_t& unitPos, const size_t& endUnitPos, UnitIndexPointer &units,
+          size_t& stmtPos, const size_t& endStmtPos, JacobiStatementInt* &statements) {
+        evaluateStackForward<AdjointData>(startAdjPos, endAdjPos, adjointData, dataPos, endDataPos, jacobies, indices, unitPos, endUnitPos, units,
                                       stmtPos, endStmtPos, statements);
       };
       auto forwardFunc = &JacobiVector::template evaluateForward<decltype(evalFunc), AdjointData*&>;
@@ -437,7 +864,7 @@ namespace codi {
       CODI_UNUSED(value);
 
       stmtVector.reserveItems(1);
-      stmtVector.setDataAndMove((StatementInt)StatementIntInputTag);
+      stmtVector.setDataAndMove(createJacobiStatement((StatementInt)StatementIntInputTag, 0));
 
       index = indexHandler.createIndex();
     }
@@ -465,10 +892,12 @@ namespace codi {
 
       ENABLE_CHECK(OptCheckZeroIndex, 0 != index) {
         stmtVector.reserveItems(1);
-        jacobiVector.reserveItems(1);
+        reserveJacobiEntries(1);
 
-        stmtVector.setDataAndMove((StatementInt)1);
-        jacobiVector.setDataAndMove(1.0, index);
+        const size_t startUnitSize = getUnitChunkPosition();
+        pushArgument(1.0, index);
+        const StatementInt units = (StatementInt)(getUnitChunkPosition() - startUnitSize);
+        stmtVector.setDataAndMove(createJacobiStatement(1 - units, units));
 
         index = indexHandler.createIndex();
       }
@@ -0,0 +1,283 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "../configure.h"
+#include "../macros.h"
+#include "../typeFunctions.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Dependency levels of a recorded tape range for a parallel reverse evaluation.
+   *
+   * The reverse evaluation is reformulated such that each adjoint is computed by one update:
+   *
+   * \f[ \bar v = \bar v + \sum_{w = \phi(\dots, v, \dots)} \frac{\d \phi}{\d v} \bar w \f]
+   *
+   * The sum is over all statements in the range that use v as an argument. The level of a variable
+   * is one more than the largest level of the left hand sides w in the sum. All variables of one level
+   * can then be updated in parallel since they only read adjoints of lower levels and each update
+   * writes only the adjoint of its variable.
+   *
+   * The contributions of one variable are applied in the same order as in the sequential evaluation. The
+   * results are therefore identical to the sequential evaluation.
+   *
+   * The schedule is only valid for tapes with unique left hand side indices, e.g. the LinearIndexHandler.
+   * It needs to be created again if the tape is changed.
+   *
+   * @tparam     Real  The floating point type of the Jacobies.
+   * @tparam    Index  The type for the indices.
+   * @tparam Position  The position type of the tape.
+   */
+  template<typename Real, typename Index, typename Position>
+  struct LevelSchedule {
+
+    Position start; /**< The start position of the range */
+    Position end; /**< The end position of the range */
+
+    /** @brief If set, the range can only be evaluated sequentially, e.g. because it contains external functions. */
+    bool sequential;
+
+    std::vector<size_t> levelStart; /**< The start of each level in the variables */
+    std::vector<Index> variables; /**< The updated variables sorted by level */
+    std::vector<size_t> rowStart; /**< The start of the update of each variable in the entries */
+    std::vector<Real> jacobies; /**< The Jacobies of the updates */
+    std::vector<Index> lhsIndices; /**< The left hand sides w of the updates */
+    std::vector<Index> zeroIndices; /**< The left hand sides of the statements in the range */
+
+  private:
+
+    std::vector<size_t> levels;
+    std::vector<size_t> counts;
+    std::vector<Index> edgeArguments;
+    std::vector<Index> edgeLhs;
+    std::vector<Real> edgeJacobies;
+
+  public:
+
+    /**
+     * @brief Creates an empty schedule.
+     */
+    LevelSchedule() :
+      start(),
+      end(),
+      sequential(false) {}
+
+    /**
+     * @brief Remove all data and start the analysis of a new range.
+     *
+     * It has to hold start >= end.
+     *
+     * @param[in]    start  The start position of the range.
+     * @param[in]      end  The end position of the range.
+     * @param[in] maxIndex  The largest index used in the range.
+     */
+    void begin(const Position& start, const Position& end, const Index& maxIndex) {
+      this->start = start;
+      this->end = end;
+      sequential = false;
+
+      levelStart.clear();
+      variables.clear();
+      rowStart.clear();
+      jacobies.clear();
+      lhsIndices.clear();
+      zeroIndices.clear();
+
+      levels.assign(maxIndex + 1, 0);
+      counts.assign(maxIndex + 1, 0);
+    }
+
+    /**
+     * @brief Add an argument of a statement.
+     *
+     * The statements have to be added in the reverse order of the recording.
+     *
+     * @param[in]    lhs  The left hand side of the statement.
+     * @param[in]    arg  The index of the argument.
+     * @param[in] jacobi  The Jacobi of the argument.
+     */
+    CODI_INLINE void addArgument(const Index& lhs, const Index& arg, const Real& jacobi) {
+      codiAssert((size_t)arg < levels.size());
+
+      levels[arg] = std::max(levels[arg], levels[lhs] + 1);
+      counts[arg] += 1;
+
+      edgeArguments.push_back(arg);
+      edgeLhs.push_back(lhs);
+      edgeJacobies.push_back(jacobi);
+    }
+
+    /**
+     * @brief Add the left hand side of a statement, which is reset in the reverse evaluation.
+     *
+     * @param[in] lhs  The left hand side of the statement.
+     */
+    CODI_INLINE void addResetIndex(const Index& lhs) {
+      zeroIndices.push_back(lhs);
+    }
+
+    /**
+     * @brief Sort the added arguments into the levels and release the temporary data.
+     */
+    void finalize() {
+      size_t maxLevel = 0;
+      for(size_t i = 0; i < levels.size(); ++i) {
+        maxLevel = std::max(maxLevel, levels[i]);
+      }
+
+      // Count the variables per level, level 0 has no updates.
+      levelStart.assign(maxLevel + 1, 0);
+      for(size_t i = 0; i < levels.size(); ++i) {
+        if(0 != counts[i]) {
+          levelStart[levels[i]] += 1;
+        }
+      }
+
+      size_t sum = 0;
+      for(size_t level = 0; level <= maxLevel; ++level) {
+        size_t cur = levelStart[level];
+        levelStart[level] = sum;
+        sum += cur;
+      }
+      levelStart.push_back(sum);
+
+      // Sort the variables by level, levels is reused as the slot of the variable.
+      variables.resize(sum);
+      rowStart.assign(sum + 1, 0);
+      std::vector<size_t> fill(levelStart);
+      for(size_t i = 0; i < levels.size(); ++i) {
+        if(0 != counts[i]) {
+          size_t slot = fill[levels[i]]++;
+          variables[slot] = (Index)i;
+          rowStart[slot + 1] = counts[i];
+          levels[i] = slot;
+        }
+      }
+
+      for(size_t slot = 0; slot < sum; ++slot) {
+        rowStart[slot + 1] += rowStart[slot];
+      }
+
+      // Distribute the arguments in the order they have been added.
+      jacobies.resize(edgeArguments.size());
+      lhsIndices.resize(edgeArguments.size());
+      for(size_t slot = 0; slot < sum; ++slot) {
+        counts[variables[slot]] = rowStart[slot];
+      }
+      for(size_t edge = 0; edge < edgeArguments.size(); ++edge) {
+        size_t pos = counts[edgeArguments[edge]]++;
+        jacobies[pos] = edgeJacobies[edge];
+        lhsIndices[pos] = edgeLhs[edge];
+      }
+
+      std::vector<size_t>().swap(levels);
+      std::vector<size_t>().swap(counts);
+      std::vector<Index>().swap(edgeArguments);
+      std::vector<Index>().swap(edgeLhs);
+      std::vector<Real>().swap(edgeJacobies);
+    }
+
+    /**
+     * @brief Mark the range as not suitable for the level evaluation and release the temporary data.
+     */
+    void setSequential() {
+      sequential = true;
+
+      std::vector<size_t>().swap(levels);
+      std::vector<size_t>().swap(counts);
+      std::vector<Index>().swap(edgeArguments);
+      std::vector<Index>().swap(edgeLhs);
+      std::vector<Real>().swap(edgeJacobies);
+    }
+
+    /**
+     * @brief Get the number of levels.
+     *
+     * @return The number of levels with updates.
+     */
+    size_t getLevelCount() const {
+      return levelStart.empty() ? 0 : levelStart.size() - 1;
+    }
+
+    /**
+     * @brief Evaluate the updates of all levels.
+     *
+     * If OpenMP is enabled the updates of one level are distributed over the threads.
+     *
+     * @param[in,out] adjointData  The vector of the adjoint variables.
+     *
+     * @tparam AdjointData The data for the adjoint vector it needs to support add, multiply and comparison operations.
+     */
+    template<typename AdjointData>
+    void evaluate(AdjointData* adjointData) const {
+      const size_t levelCount = getLevelCount();
+
+#ifdef _OPENMP
+      #pragma omp parallel
+#endif
+      {
+        for(size_t level = 0; level < levelCount; ++level) {
+          const long levelEnd = (long)levelStart[level + 1];
+#ifdef _OPENMP
+          #pragma omp for schedule(static)
+#endif
+          for(long slot = (long)levelStart[level]; slot < levelEnd; ++slot) {
+            AdjointData adj = adjointData[variables[slot]];
+            for(size_t pos = rowStart[slot]; pos < rowStart[slot + 1]; ++pos) {
+              const AdjointData& lhsAdj = adjointData[lhsIndices[pos]];
+              ENABLE_CHECK(OptZeroAdjoint, !isTotalZero(lhsAdj)) {
+                addScaled(adj, lhsAdj, jacobies[pos]);
+              }
+            }
+            adjointData[variables[slot]] = adj;
+          }
+        }
+
+        if(ZeroAdjointReverse) {
+          const long zeroEnd = (long)zeroIndices.size();
+#ifdef _OPENMP
+          #pragma omp for schedule(static)
+#endif
+          for(long pos = 0; pos < zeroEnd; ++pos) {
+            adjointData[zeroIndices[pos]] = AdjointData();
+          }
+        }
+      }
+    }
+  };
+}
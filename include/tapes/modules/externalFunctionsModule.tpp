@@ -45,6 +45,9 @@
  * It defines the methods setExternalFunctionChunkSize, pushExternalFunctionHandle, pushExternalFunction,
  * printExtFuncStatistics from the TapeInterface and ReverseTapeInterface.
  *
+ * It defines the methods pushReentrantExternalFunctionHandle, pushReentrantExternalFunction, isExtFuncReentrant
+ * for the concurrent evaluation of the tape.
+ *
  * It defines the methods getExtFuncPosition, getExtFuncZeroPosition, resetExtFunc, evaluateExtFunc, evaluateExtFuncForward as interface functions for the
  * including class.
  */
@@ -412,6 +415,85 @@
       }
     }
 
+    /**
+     * @brief Add an external function that can be evaluated by several threads at the same time.
+     *
+     * See pushExternalFunctionHandle and ExternalFunction::setReentrant for details.
+     *
+     * @param[in]  extFunc  The external function which is called by the tape.
+     * @param[in,out] data  The data for the external function. The tape takes ownership over the data.
+     * @param[in]  delData  The delete function for the data.
+     */
+    void pushReentrantExternalFunctionHandle(ExternalFunction::CallFunction extFunc, void* data, ExternalFunction::DeleteFunction delData){
+      ENABLE_CHECK (OptTapeActivity, isActive()){
+        ExternalFunction function(extFunc, data, delData);
+        function.setReentrant(true);
+
+        pushExternalFunctionHandle(function);
+      }
+    }
+
+    /**
+     * @brief Add an external function with a specific data type that can be evaluated by several threads at the same time.
+     *
+     * See pushExternalFunction and ExternalFunction::setReentrant for details.
+     *
+     * @param[in]  extFunc  The external function which is called by the tape.
+     * @param[in,out] data  The data for the external function. The tape takes ownership over the data.
+     * @param[in]  delData  The delete function for the data.
+     */
+    template<typename Data>
+    void pushReentrantExternalFunction(typename ExternalFunctionDataHelper<TAPE_NAME<TapeTypes>, Data>::CallFunction extFunc, Data* data, typename ExternalFunctionDataHelper<TAPE_NAME<TapeTypes>, Data>::DeleteFunction delData){
+      ENABLE_CHECK (OptTapeActivity, isActive()){
+        ExternalFunction function = ExternalFunctionDataHelper<TAPE_NAME<TapeTypes>, Data>::createHandle(extFunc, data, delData);
+        function.setReentrant(true);
+
+        pushExternalFunctionHandle(function);
+      }
+    }
+
+    /**
+     * @brief Function object that checks if all external functions are reentrant.
+     */
+    struct ExtFuncReentrantCheck {
+      bool reentrant; /**< If all visited external functions are reentrant. */
+
+      /**
+       * @brief Create the function object.
+       */
+      ExtFuncReentrantCheck() :
+        reentrant(true) {}
+
+      /**
+       * @brief Check the external function.
+       *
+       * @param[in]     extFunc  The external function object.
+       * @param[in] endInnerPos  The position were the external function object was stored.
+       */
+      CODI_INLINE void operator () (ExternalFunction* extFunc, const ExtFuncChildPosition* endInnerPos) {
+        CODI_UNUSED(endInnerPos);
+
+        reentrant &= extFunc->isReentrant();
+      }
+    };
+
+    /**
+     * @brief Check if all external functions in the range can be evaluated by several threads at the same time.
+     *
+     * It has to hold start >= end.
+     *
+     * @param[in] start  The start point of the range.
+     * @param[in]   end  The end point of the range.
+     * @return True if all external functions in the range are reentrant.
+     */
+    bool isExtFuncReentrant(const ExtFuncPosition& start, const ExtFuncPosition& end) {
+      ExtFuncReentrantCheck check;
+
+      extFuncVector.forEachReverse(start, end, check);
+
+      return check.reentrant;
+    }
+
     /**
      * @brief Adds information about the external functions.
      *
@@ -121,6 +121,9 @@
      *
      */
     void deleteData() {
+      // the evaluated ranges can not be inspected without the data
+      dirtyAdjoints.mergeRanges(*this);
+
       ROOT_VECTOR.forEachChunkForward(deleteFunction, true);
     }
 
@@ -27,27 +27,31 @@
  */
 
 /*
- * In order to include this file the user has to define the preprocessor macro CHILD_VECTOR_TYPE and
- * VECTOR_TYPE.
+ * In order to include this file the user has to define the preprocessor macro CHILD_VECTOR_TYPE,
+ * UNIT_VECTOR_TYPE and VECTOR_TYPE.
  *
- * CHILD_VECTOR_TYPE defines the type of the nested vector for the data vector.
+ * CHILD_VECTOR_TYPE defines the type of the nested vector for the unit vector.
+ * UNIT_VECTOR_TYPE defines the type of the unit vector, the nested vector for the data vector.
  * VECTOR_TYPE defines the type of the data vector.
  *
  * All these macros are undefined at the end of the file.
  *
- * The module defines the structures jacobiVector.
- * The module defines the types JacobiChildVector, JacobiChildPosition, JacobiVector, JacobiChunk,
- * JacobiPosition.
+ * The module defines the structures unitVector, jacobiVector.
+ * The module defines the types JacobiChildVector, JacobiChildPosition, UnitVector, UnitChunk, UnitPosition,
+ * UnitIndexPointer, JacobiVector, JacobiChunk, JacobiPosition, JacobiDataPointer, JacobiIndexPointer.
  *
  * It defines the methods pushJacobi(1.0), pushJacobi(Mul) printJacobiStatistics from the TapeInterface and ReverseTapeInterface.
  *
- * It defines the methods evaluateJacobies, incrementAdjoints, incrementTangents, setDataChunkSize, getUsedJacobiesSize, resizeJacobi as interface functions for the
+ * It defines the methods evaluateJacobies, incrementAdjoints, incrementAdjointsBlock, incrementTangents, getStmtPosition, getUnitChunkPosition, reserveJacobiEntries, removeUnitJacobiEntry, pushJacobiEntry, pushUnitEntry, pushArgument, setDataChunkSize, getUsedJacobiesSize, resizeJacobi as interface functions for the
  * including class.
  */
 
 #ifndef CHILD_VECTOR_TYPE
   #error Please define the type of the child vector
 #endif
+#ifndef UNIT_VECTOR_TYPE
+  #error Please define the type of the unit vector
+#endif
 #ifndef VECTOR_TYPE
   #error Please define the name of the chunk vector type.
 #endif
@@ -58,12 +62,24 @@
   // All definitions of the module
   // ----------------------------------------------------------------------
 
-    /** @brief The child vector for the Jacobi data vector. */
+    /** @brief The child vector for the unit vector. */
     typedef CHILD_VECTOR_TYPE JacobiChildVector;
 
     /** @brief The position type of the Jacobi child vector */
     typedef typename JacobiChildVector::Position JacobiChildPosition;
 
+    /** @brief The vector for the arguments with the jacobies 1.0 and -1.0, see ImplicitUnitJacobies. */
+    typedef UNIT_VECTOR_TYPE UnitVector;
+
+    /** @brief The data for the unit arguments. */
+    typedef typename UnitVector::ChunkType UnitChunk;
+
+    /** @brief The position type of the unit vector. */
+    typedef typename UnitVector::Position UnitPosition;
+
+    /** @brief The pointer type for the unit arguments in the evaluation routines. */
+    typedef typename PointerHandle<UnitChunk>::Pointer1 UnitIndexPointer;
+
     /** @brief The vector for the jacobi data. */
     typedef VECTOR_TYPE JacobiVector;
 
@@ -73,9 +89,25 @@
     /** @brief The position type of the jacobi module. */
     typedef typename JacobiVector::Position JacobiPosition;
 
+    /** @brief The pointer type for the jacobies in the evaluation routines. */
+    typedef typename PointerHandle<JacobiChunk>::Pointer1 JacobiDataPointer;
+
+    /** @brief The pointer type for the indices in the evaluation routines. */
+    typedef typename PointerHandle<JacobiChunk>::Pointer2 JacobiIndexPointer;
+
+    /** @brief The arguments with the jacobies 1.0 and -1.0 of each statement. Only used if ImplicitUnitJacobies is enabled. */
+    UnitVector unitVector;
+
     /** @brief The data for the jacobies of each statements. */
     JacobiVector jacobiVector;
 
+    /** @brief The encoding of the entries in the unit vector. The entries are (index << UnitJacobiTagBits) | sign. */
+    enum UnitJacobiTag {
+      UnitJacobiPlusOne = 0,
+      UnitJacobiMinusOne = 1,
+      UnitJacobiTagBits = 1
+    };
+
   private:
 
   // ----------------------------------------------------------------------
@@ -89,26 +121,81 @@
      *
      * \f[ \bar v_i += \frac{\d \phi}{\d v_i} \bar w \f]
      *
-     * The \f[ v_i \f] are the arguments of the statement and are taken from the input jacobi and indices.
+     * The \f[ v_i \f] are the arguments of the statement and are taken from the input jacobi and indices and from
+     * the unit arguments.
      * The value \f[ \bar w \f] is taken from the input adj.
      *
-     * @param[in]                  adj  The adjoint of the lhs of the statement.
-     * @param[in,out]         adjoints  The adjoint vector containing the adjoints of all variables.
-     * @param[in]      activeVariables  The number of active arguments on the rhs.
-     * @param[int,out]         dataPos  The position inside the jacobi and indices vectors. It is decremented by the number of active variables.
-     * @param[in]             jacobies  The jacobies from the arguments of the statement.
-     * @param[in]              indices  The indices from the arguments of the statements.
+     * @param[in]            adj  The adjoint of the lhs of the statement.
+     * @param[in,out]   adjoints  The adjoint vector containing the adjoints of all variables.
+     * @param[in]      statement  The data of the statement with the number of active arguments on the rhs.
+     * @param[int,out]   dataPos  The position inside the jacobi and indices vectors. It is decremented by the number of jacobi arguments.
+     * @param[in]       jacobies  The jacobies from the arguments of the statement.
+     * @param[in]        indices  The indices from the arguments of the statements.
+     * @param[int,out]   unitPos  The position inside the unit vector. It is decremented by the number of unit arguments.
+     * @param[in]          units  The unit arguments of the statements.
      */
      template<typename AdjointData>
-     CODI_INLINE void incrementAdjoints(const AdjointData& adj, AdjointData* adjoints, const StatementInt& activeVariables, size_t& dataPos, Real* &jacobies, Index* &indices) {
+     CODI_INLINE void incrementAdjoints(const AdjointData& adj, AdjointData* adjoints, const JacobiStatementInt& statement, size_t& dataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices, size_t& unitPos, UnitIndexPointer &units) {
+      const StatementInt activeVariables = getJacobiCount(statement);
       ENABLE_CHECK(OptZeroAdjoint, !isTotalZero(adj)){
         for(StatementInt curVar = 0; curVar < activeVariables; ++curVar) {
           --dataPos;
-          adjoints[indices[dataPos]] += adj * jacobies[dataPos];
+          addScaled(adjoints[indices[dataPos]], adj, jacobies[dataPos]);
+        }
 
+        if(ImplicitUnitJacobies) {
+          for(StatementInt curVar = 0; curVar < getUnitCount(statement); ++curVar) {
+            --unitPos;
+            const Index& entry = units[unitPos];
+            if(UnitJacobiMinusOne & entry) {
+              adjoints[entry >> UnitJacobiTagBits] -= adj;
+            } else {
+              adjoints[entry >> UnitJacobiTagBits] += adj;
+            }
+          }
         }
       } else {
         dataPos -= activeVariables;
+        unitPos -= getUnitCount(statement);
+      }
+    }
+
+    /**
+     * @brief Perform the adjoint update of the reverse AD sweep for all directions of a block adjoint.
+     *
+     * The same update as in incrementAdjoints is performed on each row of the arguments.
+     *
+     * @param[in]            adj  The row with the adjoints of the lhs of the statement.
+     * @param[in,out]      block  The block adjoint containing the adjoints of all variables.
+     * @param[in]      statement  The data of the statement with the number of active arguments on the rhs.
+     * @param[int,out]   dataPos  The position inside the jacobi and indices vectors. It is decremented by the number of jacobi arguments.
+     * @param[in]       jacobies  The jacobies from the arguments of the statement.
+     * @param[in]        indices  The indices from the arguments of the statements.
+     * @param[int,out]   unitPos  The position inside the unit vector. It is decremented by the number of unit arguments.
+     * @param[in]          units  The unit arguments of the statements.
+     */
+     CODI_INLINE void incrementAdjointsBlock(const Real* adj, BlockAdjoint<Real>* block, const JacobiStatementInt& statement, size_t& dataPos, JacobiDataPointer &jacobies, JacobiIndexPointer &indices, size_t& unitPos, UnitIndexPointer &units) {
+      const StatementInt activeVariables = getJacobiCount(statement);
+      ENABLE_CHECK(OptZeroAdjoint, !block->isTotalZero(adj)){
+        for(StatementInt curVar = 0; curVar < activeVariables; ++curVar) {
+          --dataPos;
+          block->addScaledRow(indices[dataPos], adj, jacobies[dataPos]);
+        }
+
+        if(ImplicitUnitJacobies) {
+          for(StatementInt curVar = 0; curVar < getUnitCount(statement); ++curVar) {
+            --unitPos;
+            const Index& entry = units[unitPos];
+            if(UnitJacobiMinusOne & entry) {
+              block->subRow(entry >> UnitJacobiTagBits, adj);
+            } else {
+              block->addRow(entry >> UnitJacobiTagBits, adj);
+            }
+          }
+        }
+      } else {
+        dataPos -= activeVariables;
+        unitPos -= getUnitCount(statement);
       }
     }
 
@@ -119,22 +206,203 @@
      *
      * \f[ \dot w += \sum_i \frac{\d \phi}{\d v_i} \dot v_i \f]
      *
-     * The \f[ v_i \f] are the arguments of the statement and are taken from the input jacobi and indices.
+     * The \f[ v_i \f] are the arguments of the statement and are taken from the input jacobi and indices and from
+     * the unit arguments.
      * The value \f[ \dot w \f] is taken from the input adj.
      *
-     * @param[in]                  adj  The tangent of the lhs of the statement.
-     * @param[in,out]         adjoints  The adjoint vector containing the tangent of all variables.
-     * @param[in]      activeVariables  The number of active arguments on the rhs.
-     * @param[int,out]         dataPos  The position inside the jacobi and indices vectors. It is decremented by the number of active variables.
-     * @param[in]             jacobies  The jacobies from the arguments of the statement.
-     * @param[in]              indices  The indices from the arguments of the statements.
+     * @param[in]            adj  The tangent of the lhs of the statement.
+     * @param[in,out]   adjoints  The adjoint vector containing the tangent of all variables.
+     * @param[in]      statement  The data of the statement with the number of active arguments on the rhs.
+     * @param[int,out]   dataPos  The position inside the jacobi and indices vectors. It is incremented by the number of jacobi arguments.
+     * @param[in]       jacobies  The jacobies from the arguments of the statement.
+     * @param[in]        indices  The indices from the arguments of the statements.
+     * @param[int,out]   unitPos  The position inside the unit vector. It is incremented by the number of unit arguments.
+     * @param[in]          units  The unit arguments of the statements.
      */
     template<typename AdjointData>
-    CODI_INLINE void incrementTangents(AdjointData& adj, const AdjointData* adjoints, const StatementInt& activeVariables, size_t& dataPos, const Real* jacobies, const Index* indices) {
+    CODI_INLINE void incrementTangents(AdjointData& adj, const AdjointData* adjoints, const JacobiStatementInt& statement, size_t& dataPos, const JacobiDataPointer& jacobies, const JacobiIndexPointer& indices, size_t& unitPos, const UnitIndexPointer& units) {
+      const StatementInt activeVariables = getJacobiCount(statement);
       for(StatementInt curVar = 0; curVar < activeVariables; ++curVar) {
-        adj += adjoints[indices[dataPos]] * jacobies[dataPos];
+        addScaled(adj, adjoints[indices[dataPos]], jacobies[dataPos]);
         dataPos += 1;
       }
+
+      if(ImplicitUnitJacobies) {
+        for(StatementInt curVar = 0; curVar < getUnitCount(statement); ++curVar) {
+          const Index& entry = units[unitPos];
+          if(UnitJacobiMinusOne & entry) {
+            adj -= adjoints[entry >> UnitJacobiTagBits];
+          } else {
+            adj += adjoints[entry >> UnitJacobiTagBits];
+          }
+          unitPos += 1;
+        }
+      }
+    }
+
+    /**
+     * @brief The position of the statement vector in a position of the unit vector.
+     *
+     * The unit vector adds a level to the positions only if ImplicitUnitJacobies is enabled.
+     *
+     * @param[in] pos  A position of the unit vector.
+     *
+     * @return The position of the nested statement vector.
+     */
+    static CODI_INLINE const JacobiChildPosition& getStmtPosition(const UnitPosition& pos) {
+      return getStmtPosition(pos, std::integral_constant<bool, ImplicitUnitJacobies>());
+    }
+
+    /**
+     * @brief The unit vector has its own level in the position.
+     *
+     * @param[in] pos  A position of the unit vector.
+     *
+     * @return The inner position.
+     *
+     * @tparam Pos  The position type of the unit vector.
+     */
+    template<typename Pos>
+    static CODI_INLINE const JacobiChildPosition& getStmtPosition(const Pos& pos, std::true_type) {
+      return pos.inner;
+    }
+
+    /**
+     * @brief The unit vector passes through to the statement vector.
+     *
+     * @param[in] pos  A position of the unit vector.
+     *
+     * @return The same position.
+     *
+     * @tparam Pos  The position type of the unit vector.
+     */
+    template<typename Pos>
+    static CODI_INLINE const JacobiChildPosition& getStmtPosition(const Pos& pos, std::false_type) {
+      return pos;
+    }
+
+    /**
+     * @brief The position in the current chunk of the unit vector.
+     *
+     * @return Zero if ImplicitUnitJacobies is disabled.
+     */
+    CODI_INLINE size_t getUnitChunkPosition() const {
+      if(ImplicitUnitJacobies) {
+        return unitVector.getChunkPosition();
+      } else {
+        return 0;
+      }
+    }
+
+    /**
+     * @brief Reserve the space for the arguments of one statement in the jacobi and unit vector.
+     *
+     * @param[in] size  The maximum number of arguments.
+     */
+    CODI_INLINE void reserveJacobiEntries(const size_t size) {
+      jacobiVector.reserveItems(size);
+      if(ImplicitUnitJacobies) {
+        unitVector.reserveItems(size);
+      }
+    }
+
+    /**
+     * @brief Remove the single argument of the last statement if its jacobi is 1.0.
+     *
+     * The argument is the last entry either in the jacobi vector or in the unit vector.
+     * Only for floating point types the comparison includes all the information of the jacobi.
+     *
+     * @param[in]  dataPos  The position of the statement arguments in the current chunk of the jacobi vector.
+     * @param[in]  unitPos  The position of the statement arguments in the current chunk of the unit vector.
+     * @param[out]   index  The index of the argument if the entry was removed.
+     *
+     * @return true if the entry was removed.
+     */
+    CODI_INLINE bool removeUnitJacobiEntry(const size_t& dataPos, const size_t& unitPos, Index& index) {
+      if(unitPos != getUnitChunkPosition()) {
+        codiAssert(unitPos + 1 == unitVector.getChunkPosition());
+
+        PointerHandle<UnitChunk> entry;
+        unitVector.getDataPointer(unitPos, entry);
+
+        if(UnitJacobiMinusOne & entry.p1[0]) {
+          return false;
+        }
+
+        index = entry.p1[0] >> UnitJacobiTagBits;
+
+        UnitPosition pos = unitVector.getPosition();
+        pos.data = unitPos;
+        unitVector.reset(pos);
+
+        return true;
+      }
+
+      codiAssert(dataPos + 1 == jacobiVector.getChunkPosition());
+
+      PointerHandle<JacobiChunk> entry;
+      jacobiVector.getDataPointer(dataPos, entry);
+
+      if(std::is_floating_point<Real>::value && PassiveReal(1.0) == entry.p1[0]) {
+        index = entry.p2[0];
+
+        JacobiPosition pos = jacobiVector.getPosition();
+        pos.data = dataPos;
+        jacobiVector.reset(pos);
+
+        return true;
+      }
+
+      return false;
+    }
+
+    /**
+     * @brief Store one argument of a statement in the jacobi vector.
+     *
+     * @param[in] jacobi  The jacobi of the argument.
+     * @param[in]  index  The index of the argument.
+     */
+    CODI_INLINE void pushJacobiEntry(const Real& jacobi, const Index& index) {
+      jacobiVector.setDataAndMove(jacobi, index);
+    }
+
+    /**
+     * @brief Store one argument with the jacobi 1.0 or -1.0 in the unit vector.
+     *
+     * The index has to be representable after the shift by UnitJacobiTagBits.
+     *
+     * @param[in]    index  The index of the argument.
+     * @param[in] negative  If the jacobi is -1.0.
+     */
+    CODI_INLINE void pushUnitEntry(const Index& index, const bool negative) {
+      codiAssert(ImplicitUnitJacobies && index <= (std::numeric_limits<Index>::max() >> UnitJacobiTagBits));
+
+      unitVector.setDataAndMove((Index)((index << UnitJacobiTagBits) | (negative ? UnitJacobiMinusOne : UnitJacobiPlusOne)));
+    }
+
+    /**
+     * @brief Store one argument of a statement.
+     *
+     * If ImplicitUnitJacobies is enabled, the arguments with the jacobies 1.0 and -1.0 are stored in the unit vector
+     * without their jacobi. Only for floating point types the comparison includes all the information of the jacobi.
+     * Arguments with an index that can not be shifted for the sign keep their jacobi.
+     *
+     * @param[in] jacobi  The jacobi of the argument.
+     * @param[in]  index  The index of the argument.
+     */
+    CODI_INLINE void pushArgument(const Real& jacobi, const Index& index) {
+      if(ImplicitUnitJacobies && std::is_floating_point<Real>::value &&
+         index <= (std::numeric_limits<Index>::max() >> UnitJacobiTagBits)) {
+        if(PassiveReal(1.0) == jacobi) {
+          pushUnitEntry(index, false);
+          return;
+        } else if(PassiveReal(-1.0) == jacobi) {
+          pushUnitEntry(index, true);
+          return;
+        }
+      }
+
+      pushJacobiEntry(jacobi, index);
     }
 
     /**
@@ -147,6 +415,9 @@
      */
     void resizeJacobi(const size_t& dataSize) {
       jacobiVector.resize(dataSize);
+      if(ImplicitUnitJacobies) {
+        unitVector.resize(dataSize);
+      }
     }
 
   public:
@@ -162,6 +433,9 @@
      */
     void setDataChunkSize(const size_t& dataChunkSize) {
       jacobiVector.setChunkSize(dataChunkSize);
+      if(ImplicitUnitJacobies) {
+        unitVector.setChunkSize(dataChunkSize);
+      }
     }
 
 
@@ -179,7 +453,7 @@
       CODI_UNUSED(data);
       CODI_UNUSED(value);
       ENABLE_CHECK(OptCheckZeroIndex, 0 != index) {
-        this->jacobiVector.setDataAndMove(PassiveReal(1.0), index);
+        pushArgument(PassiveReal(1.0), index);
       }
     }
 
@@ -200,7 +474,7 @@
       ENABLE_CHECK(OptCheckZeroIndex, 0 != index) {
         ENABLE_CHECK(OptIgnoreInvalidJacobies, codi::isfinite(jacobi)) {
           ENABLE_CHECK(OptJacobiIsZero, !isTotalZero(jacobi)) {
-            this->jacobiVector.setDataAndMove(jacobi, index);
+            pushArgument(jacobi, index);
           }
         }
       }
@@ -211,6 +485,8 @@
      *
      * See also the documentation in TapeReverseInterface::pushJacobiManual.
      *
+     * The jacobi is always stored, ImplicitUnitJacobies does not apply to the manual push.
+     *
      * @param[in]   jacobi  Stored in the constant vector.
      * @param[in]    value  Not used in this implementation.
      * @param[in]    index  Stored in the index vector.
@@ -218,7 +494,7 @@
     CODI_INLINE void pushJacobiManual(const Real& jacobi, const Real& value, const Index& index) {
       CODI_UNUSED(value);
 
-      this->jacobiVector.setDataAndMove(jacobi, index);
+      pushJacobiEntry(jacobi, index);
     }
 
     /**
@@ -242,14 +518,30 @@
       values.addData("Number of Chunks", nChunksData);
       values.addData("Memory used", memoryUsedData, true, false);
       values.addData("Memory allocated", memoryAllocData, false, true);
+
+      if(ImplicitUnitJacobies) {
+        size_t nChunksUnit   = unitVector.getNumChunks();
+        size_t totalUnit     = unitVector.getDataSize();
+        size_t sizeUnitEntry = UnitChunk::EntrySize;
+
+        double  memoryUsedUnit = (double)totalUnit*(double)(sizeUnitEntry)* BYTE_TO_MB;
+        double  memoryAllocUnit= (double)nChunksUnit*(double)unitVector.getChunkSize()
+                                  *(double)(sizeUnitEntry)* BYTE_TO_MB;
+
+        values.addSection("Unit Jacobi entries");
+        values.addData("Total Number", totalUnit);
+        values.addData("Number of Chunks", nChunksUnit);
+        values.addData("Memory used", memoryUsedUnit, true, false);
+        values.addData("Memory allocated", memoryAllocUnit, false, true);
+      }
     }
 
     /**
      * @brief Return the number of used data entries.
-     * @return The number of used data entries.
+     * @return The number of used data entries, including the entries of the unit vector.
      */
     size_t getUsedDataEntriesSize() const {
-      return jacobiVector.getDataSize();
+      return jacobiVector.getDataSize() + unitVector.getDataSize();
     }
 
     /**
@@ -283,4 +575,5 @@
     }
 
 #undef CHILD_VECTOR_TYPE
+#undef UNIT_VECTOR_TYPE
 #undef VECTOR_TYPE
@@ -45,7 +45,7 @@
  *
  * It defines the methods store(Expr), store(const), store(User), pushJacobi, printPrimalValueStatistics from the TapeInterface and ReverseTapeInterface.
  *
- * It defines the methods resizePrimals, checkPrimalsSize, evaluateHandle, evaluateConstantValues, getUsedStatementsSize,
+ * It defines the methods resizePrimals, cleanPrimalValueModule, checkPrimalsSize, evaluateHandle, evaluateConstantValues, getUsedStatementsSize,
  * getUsedDataEntiresSize, getUsedConstantDataSize, setConstantDataSize, swapPrimalValueModule as interface functions for the including class.
  *
  * It defines the static methods inputHandleFunc, copyHandleFunc, preaccHandleFunc as interface functions for the tape.
@@ -150,10 +150,17 @@
       Index oldSize = primalsSize;
       primalsSize = size;
 
-      primals = (Real*)realloc(primals, sizeof(Real) * (size_t)primalsSize);
+      primals = ZeroPageArray<Real>::resize(primals, (size_t)oldSize, (size_t)primalsSize);
+    }
 
-      for(Index i = oldSize; i < primalsSize; ++i) {
-        primals[i] = Real();
+    /**
+     * @brief Helper function: Deletes the primal vector.
+     */
+    void cleanPrimalValueModule() {
+      if(NULL != primals) {
+        ZeroPageArray<Real>::release(primals, (size_t)primalsSize);
+        primals = NULL;
+        primalsSize = 0;
       }
     }
 
@@ -164,9 +171,10 @@
      */
     CODI_INLINE void checkPrimalsSize() {
       if(primalsSize <= indexHandler.getMaximumGlobalIndex()) {
-        Index newSize = 1 + (indexHandler.getMaximumGlobalIndex() + 1) / primalsIncr;
-        newSize = newSize * primalsIncr;
-        resizePrimals(newSize);
+        // compute in size_t, the rounded size may not be representable by the index type
+        size_t newSize = 1 + ((size_t)indexHandler.getMaximumGlobalIndex() + 1) / (size_t)primalsIncr;
+        newSize = std::min(newSize * (size_t)primalsIncr, (size_t)std::numeric_limits<Index>::max());
+        resizePrimals((Index)newSize);
       }
     }
 
@@ -123,7 +123,8 @@
      *
      * The jacobies and the indices of the rhs expression are
      * stored on the tape. Also the number of active variables
-     * is stored in the statement vector.
+     * is stored in the statement vector. If ImplicitUnitJacobies is enabled, the arguments
+     * with the jacobies 1.0 and -1.0 are counted separately.
      *
      * The gradient data of the lhs will get a new index.
      * The primal value of the lhs is set to the primal value of the rhs.
@@ -143,28 +144,37 @@
 
       ENABLE_CHECK (OptTapeActivity, active){
         stmtVector.reserveItems(1);
-        JACOBI_VECTOR_NAME.reserveItems(ExpressionTraits<Rhs>::maxActiveVariables);
+        reserveJacobiEntries(ExpressionTraits<Rhs>::maxActiveVariables);
         /* first store the size of the current stack position and evaluate the
          rhs expression. If there was an active variable on the rhs, update
          the index of the lhs */
         size_t startSize = JACOBI_VECTOR_NAME.getChunkPosition();
+        size_t startUnitSize = getUnitChunkPosition();
         rhs.template calcGradient<void*>(null);
         rhs.template pushLazyJacobies<void*>(null);
-        size_t activeVariables = JACOBI_VECTOR_NAME.getChunkPosition() - startSize;
+        size_t jacobiVariables = JACOBI_VECTOR_NAME.getChunkPosition() - startSize;
+        size_t unitVariables = getUnitChunkPosition() - startUnitSize;
+        size_t activeVariables = jacobiVariables + unitVariables;
         ENABLE_CHECK(OptCheckEmptyStatements, 0 != activeVariables) {
 
-          indexHandler.assignIndex(lhsIndex);
-          STATEMENT_PUSH_FUNCTION_NAME((StatementInt)activeVariables, lhsIndex);
+          Index rhsIndex = 0;
+          if(OptCopyElimination && LinearIndexHandler && 1 == activeVariables && removeUnitJacobiEntry(startSize, startUnitSize, rhsIndex)) {
+            // the statement only copies the derivative, the lhs shares the index of the argument
+            lhsIndex = rhsIndex;
+          } else {
+            indexHandler.assignIndex(lhsIndex);
+            STATEMENT_PUSH_FUNCTION_NAME(createJacobiStatement((StatementInt)jacobiVariables, (StatementInt)unitVariables), lhsIndex);
 
 #if CODI_AdjointHandle_Jacobi
-          Real* jacobies = NULL;
-          Index* rhsIndices = NULL;
+            Real* jacobies = NULL;
+            Index* rhsIndices = NULL;
 
-          auto pos = JACOBI_VECTOR_NAME.getPosition();
-          JACOBI_VECTOR_NAME.getDataAtPosition(pos.chunk, startSize, jacobies, rhsIndices);
+            auto pos = JACOBI_VECTOR_NAME.getPosition();
+            JACOBI_VECTOR_NAME.getDataAtPosition(pos.chunk, startSize, jacobies, rhsIndices);
 
-          handleAdjointOperation(rhs.getValue(), lhsIndex, jacobies, rhsIndices, activeVariables);
+            handleAdjointOperation(rhs.getValue(), lhsIndex, jacobies, rhsIndices, jacobiVariables);
 #endif
+          }
         } else {
           indexHandler.freeIndex(lhsIndex);
         }
@@ -198,6 +208,7 @@
      * Use this routine to add a statement if the corresponding jacobi entries will be manually pushed onto the tape.
      *
      * The Jacobi entries must be pushed immediately after calling this routine using pushJacobiManual.
+     * All entries are stored with their jacobi.
      *
      * See also the documentation in TapeInterfaceReverse::storeManual.
      *
@@ -211,7 +222,7 @@
       stmtVector.reserveItems(1);
       JACOBI_VECTOR_NAME.reserveItems(size);
       indexHandler.assignIndex(lhsIndex);
-      STATEMENT_PUSH_FUNCTION_NAME(size, lhsIndex);
+      STATEMENT_PUSH_FUNCTION_NAME(createJacobiStatement(size, 0), lhsIndex);
     }
 
     /**
@@ -39,10 +39,13 @@
  *
  * TAPE_NAME defines the type name of the tape and is not undefined at the end of the file.
  *
- * The module defines the structures adjoints, adjointSize and active that have to initialized
+ * The module defines the structures adjoints, adjointSize, dirtyAdjoints and active that have to initialized
  * in the including class.
  * The module defines the types Position.
  *
+ * The including class has to define the method forEachAdjointIndex, which is used by dirtyAdjoints to find the
+ * adjoint values of the evaluated tape ranges.
+ *
  * It defines the methods initGradientData, destroyGradientData, setGradient, getGradient, gradient, clearAdjoints,
  * reset(Pos), reset(), evaluate(), evaluate(Pos, Pos), evaluateForward(), evaluateForward(Pos, Pos), setActive,
  * setPassive, isActive, print Statistics from the TapeInterface and ReverseTapeInterface.
@@ -100,6 +103,9 @@
     /** @brief The current size of the adjoint vector. */
     Index adjointsSize;
 
+    /** @brief The part of the adjoint vector that is reset by clearAdjoints. */
+    DirtyAdjointRange<Index, Position> dirtyAdjoints;
+
     /**
      * @brief Determines if statements are recorded or ignored.
      */
@@ -120,19 +126,7 @@
       Index oldSize = adjointsSize;
       adjointsSize = size;
 
-      for(Index i = adjointsSize; i < oldSize; ++i) {
-        adjoints[i].~GradientValue();
-      }
-
-      adjoints = (GradientValue*)realloc(adjoints, sizeof(GradientValue) * (size_t)adjointsSize);
-
-      if(NULL == adjoints) {
-        throw std::bad_alloc();
-      }
-
-      for(Index i = oldSize; i < adjointsSize; ++i) {
-        new (adjoints + i) GradientValue();
-      }
+      adjoints = ZeroPageArray<GradientValue>::resize(adjoints, (size_t)oldSize, (size_t)adjointsSize);
     }
 
     /**
@@ -149,10 +143,11 @@
      */
     void cleanTapeBase() {
       if(NULL != adjoints) {
-        free(adjoints);
+        ZeroPageArray<GradientValue>::release(adjoints, (size_t)adjointsSize);
         adjoints = NULL;
         adjointsSize = 0;
       }
+      dirtyAdjoints.reset();
     }
 
     /**
@@ -163,6 +158,7 @@
     void swapTapeBaseModule(TAPE_NAME<TapeTypes>& other) {
       std::swap(adjoints, other.adjoints);
       std::swap(adjointsSize, other.adjointsSize);
+      dirtyAdjoints.swap(other.dirtyAdjoints);
       std::swap(active, other.active);
 
       // the index handler is not swaped because it is either swaped in the recursive call to of the data vectors
@@ -264,6 +260,7 @@
       if(adjointsSize <= index) {
         resizeAdjoints(INDEX_HANDLER_NAME.getMaximumGlobalIndex() + 1);
       }
+      dirtyAdjoints.addIndex(index);
 
       return adjoints[index];
     }
@@ -284,12 +281,15 @@
 
     /**
      * @brief Sets all adjoint/gradients to zero.
+     *
+     * Only the adjoint values which have been accessed with gradient or setGradient and the adjoint values of the
+     * tape ranges which have been evaluated since the last clear are reset, see DirtyAdjointRange.
      */
     CODI_INLINE void clearAdjoints(){
       if(NULL != adjoints) {
-        for(Index i = 0; i < adjointsSize; ++i) {
-          adjoints[i] = GradientValue();
-        }
+        dirtyAdjoints.clear(*this, adjoints, (size_t)adjointsSize, true);
+      } else {
+        dirtyAdjoints.reset();
       }
     }
 
@@ -299,6 +299,8 @@
      * @param[in] pos Reset the state of the tape to the given position.
      */
     CODI_INLINE void reset(const Position& pos) {
+      // the evaluated ranges can not be inspected after the data is removed
+      dirtyAdjoints.mergeRanges(*this);
       clearAdjoints(getPosition(), pos);
 
       // reset will be done iteratively through the vectors
@@ -344,7 +346,10 @@
     CODI_NO_INLINE void evaluate(const Position& start, const Position& end) {
       resizeAdjointsToIndexSize();
 
+      // the evaluation can use the marks of the adjoint vector before the range is added
       evaluate(start, end, adjoints);
+
+      dirtyAdjoints.addRange(*this, start, end);
     }
 
     /**
@@ -380,6 +385,7 @@
      */
     CODI_NO_INLINE void evaluateForward(const Position& start, const Position& end) {
       resizeAdjointsToIndexSize();
+      dirtyAdjoints.addRange(*this, end, start);
 
       evaluateForward(start, end, adjoints);
     }
@@ -472,7 +478,7 @@
     */
     void addTapeBaseValues(TapeValues& values) const {
 
-      size_t nAdjoints      = INDEX_HANDLER_NAME.getMaximumGlobalIndex() + 1;
+      size_t nAdjoints      = (size_t)INDEX_HANDLER_NAME.getMaximumGlobalIndex() + 1;
       double memoryAdjoints = (double)nAdjoints * (double)sizeof(GradientValue) * BYTE_TO_MB;
 
       values.addSection("Adjoint vector");
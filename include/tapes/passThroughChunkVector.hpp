@@ -0,0 +1,314 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "pointerHandle.hpp"
+#include "../configure.h"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief A chunk vector without data, that forwards everything to its nested vector.
+   *
+   * The vector replaces an optional chunk vector in a chain of chunk vectors. It adds no level to the positions
+   * and no chunks to the iteration, so the chain is the same as if the outer vector were nested directly on the
+   * nested vector of this one.
+   *
+   * For the evaluation the empty range zero to zero and null pointers are added to the arguments, such that the
+   * function objects have the same signature as with a ChunkVector in the chain.
+   *
+   * The data interface of the ChunkVector is implemented with empty functions. It must not be used to store data.
+   *
+   * @tparam ChunkData     The chunk type the replaced vector would store.
+   * @tparam NestedVector  The nested chunk vector.
+   */
+  template<typename ChunkData, typename NestedVector>
+  struct PassThroughChunkVector {
+
+    /** @brief The chunk type the replaced vector would store. */
+    typedef ChunkData ChunkType;
+
+    /** @brief The position is the position of the nested vector. */
+    typedef typename NestedVector::Position Position;
+
+    NestedVector* nested; /**< Pointer to the nested vector. */
+
+    /**
+     * @brief Creates the vector on top of the nested vector.
+     *
+     * @param chunkSize  Not used.
+     * @param    nested  The nested chunk vector.
+     */
+    PassThroughChunkVector(const size_t& chunkSize, NestedVector* nested) :
+      nested(nested)
+    {
+      CODI_UNUSED(chunkSize);
+    }
+
+    /**
+     * @brief Swap the nested vectors.
+     *
+     * @param[in,out] other  The other vector.
+     */
+    void swap(PassThroughChunkVector& other) {
+      nested->swap(*other.nested);
+    }
+
+    /**
+     * @brief Do nothing.
+     *
+     * @param[in] chunkSize  Not used.
+     */
+    void setChunkSize(const size_t& chunkSize) {
+      CODI_UNUSED(chunkSize);
+    }
+
+    /**
+     * @brief Do nothing.
+     *
+     * @param[in] totalSize  Not used.
+     */
+    void resize(const size_t& totalSize) {
+      CODI_UNUSED(totalSize);
+    }
+
+    /**
+     * @brief Reset the nested vector.
+     *
+     * @param[in] pos  The position of the nested vector.
+     */
+    CODI_INLINE void reset(const Position& pos) {
+      nested->reset(pos);
+    }
+
+    /**
+     * @brief Reset the nested vector to the zero position.
+     */
+    CODI_INLINE void reset() {
+      nested->reset(nested->getZeroPosition());
+    }
+
+    /**
+     * @brief Reset the nested vector and free its memory.
+     */
+    CODI_INLINE void resetHard() {
+      nested->resetHard();
+    }
+
+    /**
+     * @brief Do nothing.
+     *
+     * @param[in] items  Not used.
+     */
+    CODI_INLINE void reserveItems(const size_t items) {
+      CODI_UNUSED(items);
+    }
+
+    /**
+     * @brief Do nothing. The vector can not store data.
+     *
+     * @param[in] data  Not used.
+     *
+     * @tparam Data  The types of the data.
+     */
+    template<typename ... Data>
+    CODI_INLINE void setDataAndMove(const Data& ... data) {
+      CODI_UNUSED_VAR(data...);
+      codiAssert(false);
+    }
+
+    /**
+     * @brief There is no data.
+     *
+     * @return Always zero.
+     */
+    CODI_INLINE size_t getChunkPosition() const {
+      return 0;
+    }
+
+    /**
+     * @brief Do nothing. The vector has no data.
+     *
+     * @param[in]     pos  Not used.
+     * @param[out] handle  Not modified.
+     */
+    CODI_INLINE void getDataPointer(const size_t& pos, PointerHandle<ChunkType>& handle) {
+      CODI_UNUSED(pos);
+      CODI_UNUSED(handle);
+      codiAssert(false);
+    }
+
+    /**
+     * @brief The position of the nested vector.
+     *
+     * @return The position of the nested vector.
+     */
+    CODI_INLINE Position getPosition() const {
+      return nested->getPosition();
+    }
+
+    /**
+     * @brief The zero position of the nested vector.
+     *
+     * @return The zero position of the nested vector.
+     */
+    CODI_INLINE Position getZeroPosition() const {
+      return nested->getZeroPosition();
+    }
+
+    /**
+     * @brief There are no chunks.
+     *
+     * @return Always zero.
+     */
+    CODI_INLINE int getNumChunks() const {
+      return 0;
+    }
+
+    /**
+     * @brief There are no chunks.
+     *
+     * @return Always zero.
+     */
+    CODI_INLINE size_t getChunkSize() const {
+      return 0;
+    }
+
+    /**
+     * @brief There is no data.
+     *
+     * @return Always zero.
+     */
+    CODI_INLINE size_t getDataSize() const {
+      return 0;
+    }
+
+    /**
+     * @brief There is no data, that needs to be iterated.
+     *
+     * @param[in]       start  Not used.
+     * @param[in]         end  Not used.
+     * @param[in,out] function  Not called.
+     * @param[in,out]     args  Not used.
+     *
+     * @tparam Args  The data types for the arguments of the function.
+     */
+    template<typename FunctionObject, typename ... Args>
+    CODI_INLINE void forEachReverse(const Position& start, const Position& end, FunctionObject& function, Args&&... args) {
+      CODI_UNUSED(start);
+      CODI_UNUSED(end);
+      CODI_UNUSED(function);
+      CODI_UNUSED_VAR(args...);
+    }
+
+    /**
+     * @brief There is no data, that needs to be modified.
+     *
+     * @param[in]       start  Not used.
+     * @param[in]         end  Not used.
+     * @param[in,out] function  Not called.
+     * @param[in,out]     args  Not used.
+     *
+     * @tparam Args  The data types for the arguments of the function.
+     */
+    template<typename FunctionObject, typename ... Args>
+    CODI_INLINE void modifyEachReverse(const Position& start, const Position& end, FunctionObject& function, Args&&... args) {
+      CODI_UNUSED(start);
+      CODI_UNUSED(end);
+      CODI_UNUSED(function);
+      CODI_UNUSED_VAR(args...);
+    }
+
+    /**
+     * @brief Iterates over the chunks of the nested vectors, this vector has no chunks.
+     *
+     * @param  function  The function called for each chunk.
+     * @param recursive  If the chunks of the nested vectors should be iterated.
+     * @param      args  The pointers are used as the arguments for the function.
+     *
+     * @tparam  Args  The data types for the arguments of the function.
+     */
+    template<typename FunctionObject, typename ... Args>
+    CODI_INLINE void forEachChunkForward(FunctionObject& function, bool recursive, Args&&... args) {
+      if(recursive) {
+        nested->forEachChunkForward(function, recursive, std::forward<Args>(args)...);
+      }
+    }
+
+    /**
+     * @brief Reverse stack evaluation of the nested vector.
+     *
+     * The empty range zero to zero and null pointers are added to the arguments.
+     *
+     * @param    start  The start point for the stack interpretation.
+     * @param      end  The end point for the stack interpretation.
+     * @param function  The function called for each valid range.
+     * @param     args  Pointers and ranges from other chunks vectors and additional arguments for the
+     *                  function.
+     *
+     * @tparam  Args  The data types for the arguments.
+     */
+    template<typename Function, typename ... Args>
+    CODI_INLINE void evaluateReverse(const Position& start, const Position& end,const Function& function,
+                                     Args&&... args) {
+      PointerHandle<ChunkType> pHandle = PointerHandle<ChunkType>();
+      size_t dataPos = 0;
+
+      pHandle.callNestedReverse(nested, start, end, function, std::forward<Args>(args)..., dataPos, 0);
+    }
+
+    /**
+     * @brief Forward stack evaluation of the nested vector.
+     *
+     * The empty range zero to zero and null pointers are added to the arguments.
+     *
+     * @param    start  The start point for the stack interpretation.
+     * @param      end  The end point for the stack interpretation.
+     * @param function  The function called for each valid range.
+     * @param     args  Pointers and ranges from other chunks vectors and additional arguments for the
+     *                  function.
+     *
+     * @tparam  Args  The data types for the arguments.
+     */
+    template<typename Function, typename ... Args>
+    CODI_INLINE void evaluateForward(const Position& start, const Position& end,const Function& function,
+                                     Args&&... args) {
+      PointerHandle<ChunkType> pHandle = PointerHandle<ChunkType>();
+      size_t dataPos = 0;
+
+      pHandle.callNestedForward(nested, start, end, function, std::forward<Args>(args)..., dataPos, 0);
+    }
+  };
+}
@@ -72,10 +72,13 @@ namespace codi {
   /**
    * @brief Specialization for PointerHandle with a Chunk1 type.
    *
-   * @tparam Data1  The first data type for the chunk.
+   * @tparam     Data1  The first data type for the chunk.
+   * @tparam Allocator  The allocator policy of the chunk.
    */
-  template<typename Data1>
-  struct PointerHandle<Chunk1<Data1> > {
+  template<typename Data1, typename Allocator>
+  struct PointerHandle<Chunk1<Data1, Allocator> > {
+      typedef Data1* Pointer1; /**< Pointer type for the first data item. */
+
       Data1* p1; /**< Pointer for the first data item. */
 
       /**
@@ -85,7 +88,7 @@ namespace codi {
        * @param[in]     dataPos  The position of the data in the chunk that is set to the pointers.
        * @param[in,out]   chunk  The chunk from which the data is gained.
        */
-      void setPointers(const size_t& dataPos, Chunk1<Data1>* chunk) {
+      void setPointers(const size_t& dataPos, Chunk1<Data1, Allocator>* chunk) {
         chunk->dataPointer(dataPos, p1);
       }
 
@@ -129,11 +132,15 @@ namespace codi {
   /**
    * @brief Specialization for PointerHandle with a Chunk2 type.
    *
-   * @tparam Data1  The first data type for the chunk.
-   * @tparam Data2  The second data type for the chunk.
+   * @tparam     Data1  The first data type for the chunk.
+   * @tparam     Data2  The second data type for the chunk.
+   * @tparam Allocator  The allocator policy of the chunk.
    */
-  template<typename Data1, typename Data2>
-  struct PointerHandle<Chunk2<Data1, Data2> > {
+  template<typename Data1, typename Data2, typename Allocator>
+  struct PointerHandle<Chunk2<Data1, Data2, Allocator> > {
+      typedef Data1* Pointer1; /**< Pointer type for the first data item. */
+      typedef Data2* Pointer2; /**< Pointer type for the second data item. */
+
       Data1* p1; /**< Pointer for the first data item. */
       Data2* p2; /**< Pointer for the second data item. */
 
@@ -144,7 +151,7 @@ namespace codi {
        * @param[in]     dataPos  The position of the data in the chunk that is set to the pointers.
        * @param[in,out]   chunk  The chunk from which the data is gained.
        */
-      void setPointers(const size_t& dataPos, Chunk2<Data1, Data2>* chunk) {
+      void setPointers(const size_t& dataPos, Chunk2<Data1, Data2, Allocator>* chunk) {
         chunk->dataPointer(dataPos, p1, p2);
       }
 
@@ -188,12 +195,17 @@ namespace codi {
   /**
    * @brief Specialization for PointerHandle with a Chunk3 type.
    *
-   * @tparam Data1  The first data type for the chunk.
-   * @tparam Data2  The second data type for the chunk.
-   * @tparam Data3  The third data type for the chunk.
+   * @tparam     Data1  The first data type for the chunk.
+   * @tparam     Data2  The second data type for the chunk.
+   * @tparam     Data3  The third data type for the chunk.
+   * @tparam Allocator  The allocator policy of the chunk.
    */
-  template<typename Data1, typename Data2, typename Data3>
-  struct PointerHandle<Chunk3<Data1, Data2, Data3> > {
+  template<typename Data1, typename Data2, typename Data3, typename Allocator>
+  struct PointerHandle<Chunk3<Data1, Data2, Data3, Allocator> > {
+      typedef Data1* Pointer1; /**< Pointer type for the first data item. */
+      typedef Data2* Pointer2; /**< Pointer type for the second data item. */
+      typedef Data3* Pointer3; /**< Pointer type for the third data item. */
+
       Data1* p1; /**< Pointer for the first data item. */
       Data2* p2; /**< Pointer for the second data item. */
       Data3* p3; /**< Pointer for the third data item. */
@@ -205,7 +217,7 @@ namespace codi {
        * @param[in]     dataPos  The position of the data in the chunk that is set to the pointers.
        * @param[in,out]   chunk  The chunk from which the data is gained.
        */
-      void setPointers(const size_t& dataPos, Chunk3<Data1, Data2, Data3>* chunk) {
+      void setPointers(const size_t& dataPos, Chunk3<Data1, Data2, Data3, Allocator>* chunk) {
         chunk->dataPointer(dataPos, p1, p2, p3);
       }
 
@@ -249,13 +261,19 @@ namespace codi {
   /**
    * @brief Specialization for PointerHandle with a Chunk4 type.
    *
-   * @tparam Data1  The first data type for the chunk.
-   * @tparam Data2  The second data type for the chunk.
-   * @tparam Data3  The third data type for the chunk.
-   * @tparam Data4  The fourth data type for the chunk.
+   * @tparam     Data1  The first data type for the chunk.
+   * @tparam     Data2  The second data type for the chunk.
+   * @tparam     Data3  The third data type for the chunk.
+   * @tparam     Data4  The fourth data type for the chunk.
+   * @tparam Allocator  The allocator policy of the chunk.
    */
-  template<typename Data1, typename Data2, typename Data3, typename Data4>
-  struct PointerHandle<Chunk4<Data1, Data2, Data3, Data4> > {
+  template<typename Data1, typename Data2, typename Data3, typename Data4, typename Allocator>
+  struct PointerHandle<Chunk4<Data1, Data2, Data3, Data4, Allocator> > {
+      typedef Data1* Pointer1; /**< Pointer type for the first data item. */
+      typedef Data2* Pointer2; /**< Pointer type for the second data item. */
+      typedef Data3* Pointer3; /**< Pointer type for the third data item. */
+      typedef Data4* Pointer4; /**< Pointer type for the fourth data item. */
+
       Data1* p1; /**< Pointer for the first data item. */
       Data2* p2; /**< Pointer for the second data item. */
       Data3* p3; /**< Pointer for the third data item. */
@@ -268,7 +286,7 @@ namespace codi {
        * @param[in]     dataPos  The position of the data in the chunk that is set to the pointers.
        * @param[in,out]   chunk  The chunk from which the data is gained.
        */
-      void setPointers(const size_t& dataPos, Chunk4<Data1, Data2, Data3, Data4>* chunk) {
+      void setPointers(const size_t& dataPos, Chunk4<Data1, Data2, Data3, Data4, Allocator>* chunk) {
         chunk->dataPointer(dataPos, p1, p2, p3, p4);
       }
 
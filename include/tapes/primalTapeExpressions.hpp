@@ -209,7 +209,7 @@ namespace codi {
 #if CODI_EnableVariableAdjointInterfaceInPrimalTapes
         adjointValues->updateJacobiTangent(indices[offset], seed);
 #else
-        lhsAdjoint += adjointValues[indices[offset]] * seed;
+        addScaled(lhsAdjoint, adjointValues[indices[offset]], seed);
 #endif
 
       return primalValues[indices[offset]];
@@ -278,7 +278,7 @@ namespace codi {
 #if CODI_EnableVariableAdjointInterfaceInPrimalTapes
           adjointValues->updateJacobiAdjoint(indices[i], constantValues[i] * seed);
 #else
-          adjointValues[indices[i]] += constantValues[i] * seed;
+          addScaled(adjointValues[indices[i]], seed, constantValues[i]);
 #endif
       }
     }
@@ -35,13 +35,17 @@
 #include "../activeReal.hpp"
 #include "../expressionHandle.hpp"
 #include "chunkVector.hpp"
+#include "dirtyAdjointRange.hpp"
 #include "indices/reuseIndexHandler.hpp"
 #include "handles/functionHandleFactory.hpp"
 #include "handles/staticObjectHandleFactory.hpp"
 #include "handles/staticFunctionHandleFactory.hpp"
+#include "indexCompaction.hpp"
+#include "indexRenumbering.hpp"
 #include "primalTapeExpressions.hpp"
 #include "reverseTapeInterface.hpp"
 #include "singleChunkVector.hpp"
+#include "zeroPageArray.hpp"
 #include "../tools/tapeValues.hpp"
 
 namespace codi {
@@ -139,7 +143,7 @@ namespace codi {
     EmptyChunkVector emptyVector;
 
     /** @brief The index handler for the active real's. */
-    static typename TapeTypes::IndexHandler indexHandler;
+    static CODI_TAPE_STORAGE typename TapeTypes::IndexHandler indexHandler;
 
     /** @brief Disables code path in CoDiPack that are optimized for Jacobi taping */
     static const bool AllowJacobiOptimization = false;
@@ -147,6 +151,15 @@ namespace codi {
     /** @brief This tape requires no special primal value handling since the primal value vector is not overwritten. */
     static const bool RequiresPrimalReset = true;
 
+    /** @brief The primal values are modified during the evaluation. Concurrent evaluations are not possible. */
+    static const bool AllowConcurrentEvaluation = false;
+
+    /** @brief The renumbering of the indices in a tape range, see renumberIndices. */
+    typedef IndexRenumbering<Index> IndexRenumberingType;
+
+    /** @brief The compaction of the index space, see compactIndices. */
+    typedef IndexCompaction<Index> IndexCompactionType;
+
     #define TAPE_NAME PrimalValueIndexTape
 
     #define POSITION_TYPE typename TapeTypes::Position
@@ -186,6 +199,7 @@ namespace codi {
       emptyVector(),
       /* defined in tapeBaseModule */adjoints(NULL),
       /* defined in tapeBaseModule */adjointsSize(0),
+      /* defined in tapeBaseModule */dirtyAdjoints(),
       /* defined in tapeBaseModule */active(false),
       /* defined in the primalValueModule */stmtVector(DefaultChunkSize, &emptyVector),
       /* defined in the primalValueModule */indexVector(DefaultChunkSize, &stmtVector),
@@ -200,6 +214,7 @@ namespace codi {
     /** @brief Tear down the tape. Delete all values from the modules */
     ~PrimalValueIndexTape() {
       cleanTapeBase();
+      cleanPrimalValueModule();
 
       if(NULL != primalsCopy) {
         free(primalsCopy);
@@ -252,6 +267,46 @@ namespace codi {
       }
     }
 
+    /**
+     * @brief Call the function for each index of the adjoint vector that an evaluation of the range accesses.
+     *
+     * The function is called for the left hand side and the arguments of all statements in the range. An index can
+     * be reported several times. Ranges with external functions are not inspected, since the external functions
+     * can access arbitrary adjoint values.
+     *
+     * It has to hold start >= end.
+     *
+     * @param[in]    start  The start of the range.
+     * @param[in]      end  The end of the range.
+     * @param[in,out] func  The function which is called with each index.
+     *
+     * @return false if the range contains external functions. The function is not called in this case.
+     *
+     * @tparam Func  Needs to be callable with an Index.
+     */
+    template<typename Func>
+    bool forEachAdjointIndex(const Position& start, const Position& end, Func& func) {
+      if(start.chunk != end.chunk || start.data != end.data) {
+        return false;
+      }
+
+      auto stmtFunc = [&func] (Index* lhsIndex, Real* value, Handle* handle, StatementInt* stmtSize) {
+        CODI_UNUSED(value);
+        CODI_UNUSED(handle);
+        CODI_UNUSED(stmtSize);
+
+        func(*lhsIndex);
+      };
+      stmtVector.forEachReverse(start.inner.inner.inner, end.inner.inner.inner, stmtFunc);
+
+      auto argFunc = [&func] (Index* index) {
+        func(*index);
+      };
+      indexVector.forEachReverse(start.inner.inner, end.inner.inner, argFunc);
+
+      return true;
+    }
+
     /**
      * @brief Set the size of the index and statement data and the primal vector.
      * @param[in] dataSize  The new size of the index vector.
@@ -334,6 +389,125 @@ namespace codi {
       return getExtFuncZeroPosition();
     }
 
+    /**
+     * @brief Renumber the indices of a tape range such that the reverse evaluation accesses the adjoint vector almost sequentially.
+     *
+     * The indices are numbered in the order of their access in the reverse evaluation, see IndexRenumbering
+     * for details. Only the expression handles know the number of arguments of a statement, therefore the left hand
+     * sides of each evaluated block of statements are numbered before the arguments of the block. The statements of
+     * the range, the primal vector, the adjoint vector and the index handler are updated. All active variables which
+     * still have an index of the range need to be updated with IndexRenumbering::apply afterwards, e.g. the
+     * registered inputs and outputs.
+     *
+     * The indices of the range can also be used by statements outside of the range. The new numbers are therefore
+     * applied to the whole tape. Tapes with external functions are not changed, since the external functions store
+     * their own indices.
+     *
+     * It has to hold start >= end.
+     *
+     * @param[out] renumbering  The new numbers of the indices.
+     * @param[in]        start  The start point of the range.
+     * @param[in]          end  The end point of the range.
+     */
+    void renumberIndices(IndexRenumberingType& renumbering, const Position& start, const Position& end) {
+      renumbering.begin(indexHandler.getMaximumGlobalIndex());
+
+      const Position tapeStart = getPosition();
+      const Position tapeEnd = getZeroPosition();
+
+      if(tapeStart.chunk == tapeEnd.chunk && tapeStart.data == tapeEnd.data) {
+        auto analyzeFunc = [] (IndexRenumberingType& renumbering,
+            size_t& indexPos, const size_t& endIndexPos, Index* &indices,
+            size_t& stmtPos, const size_t& endStmtPos, Index* lhsIndices, Real* storedPrimals,
+            Handle* &statements, StatementInt* &passiveActiveReal) {
+          CODI_UNUSED(storedPrimals);
+          CODI_UNUSED(statements);
+          CODI_UNUSED(passiveActiveReal);
+
+          while(stmtPos > endStmtPos) {
+            --stmtPos;
+            renumbering.addIndex(lhsIndices[stmtPos]);
+          }
+
+          while(indexPos > endIndexPos) {
+            --indexPos;
+            renumbering.addIndex(indices[indexPos]);
+          }
+        };
+
+        indexVector.evaluateReverse(start.inner.inner, end.inner.inner, analyzeFunc, renumbering);
+      }
+
+      renumbering.finalize();
+
+      if(0 != renumbering.getIndexCount()) {
+        auto stmtFunc = [&renumbering] (Index* lhsIndex, Real* value, Handle* handle, StatementInt* stmtSize) {
+          CODI_UNUSED(value);
+          CODI_UNUSED(handle);
+          CODI_UNUSED(stmtSize);
+
+          renumbering.apply(*lhsIndex);
+        };
+        stmtVector.modifyEachReverse(tapeStart.inner.inner.inner, tapeEnd.inner.inner.inner, stmtFunc);
+
+        auto indexFunc = [&renumbering] (Index* index) {
+          renumbering.apply(*index);
+        };
+        indexVector.modifyEachReverse(tapeStart.inner.inner, tapeEnd.inner.inner, indexFunc);
+
+        checkPrimalsSize();
+        renumbering.permute(primals, primalsSize);
+
+        if(NULL != adjoints) {
+          resizeAdjointsToIndexSize();
+          renumbering.permute(adjoints, adjointsSize);
+        }
+        // the marked adjoint values have been moved
+        dirtyAdjoints.addAll();
+
+        indexHandler.renumberIndices(renumbering);
+      }
+    }
+
+    /**
+     * @brief Move the live indices into a dense range and shrink the index handler and the vectors which are addressed by the indices.
+     *
+     * After a peak in the number of live indices, the index handler, the primal vector and the adjoint vector keep their size. The
+     * compaction renumbers the live indices densely, see IndexCompaction for details, and releases the memory of
+     * the removed indices. The adjoint values of the live indices are kept. All active variables need to be updated
+     * with IndexCompaction::apply afterwards.
+     *
+     * The tape needs to be empty, e.g. after a reset, since the recorded indices would become invalid. The index
+     * handler needs to count the use of the indices, e.g. ReuseIndexHandlerUseCount.
+     *
+     * @param[out] compaction  The new numbers of the indices.
+     */
+    void compactIndices(IndexCompactionType& compaction) {
+      if(getZeroPosition() != getPosition()) {
+        CODI_EXCEPTION("The indices can only be compacted if the tape is empty.");
+      }
+
+      indexHandler.compactIndices(compaction);
+      Index indexEnd = compaction.getIndexEnd();
+
+      compaction.compact(primals, primalsSize);
+      resizePrimals(std::min(primalsSize, indexEnd + 1));
+
+      if(NULL != primalsCopy) {
+        free(primalsCopy);
+        primalsCopy = NULL;
+        primalsCopySize = 0;
+      }
+
+      if(NULL != adjoints) {
+        compaction.compact(adjoints, adjointsSize);
+        resizeAdjoints(std::min(adjointsSize, indexEnd + 1));
+        ZeroPageArray<GradientValue>::zero(adjoints, std::min((size_t)indexEnd, (size_t)adjointsSize), adjointsSize);
+      }
+      // the marked adjoint values have been moved
+      dirtyAdjoints.addAll();
+    }
+
   private:
 
     /**
@@ -403,7 +577,11 @@ namespace codi {
                                           size_t& stmtPos, const size_t& endStmtPos, Index* lhsIndices, Real* storedPrimals,
                                           Handle* &statements, StatementInt* &passiveActiveReal) {
       CODI_UNUSED(endConstantPos);
+#if CODI_EnableVariableAdjointInterfaceInPrimalTapes
       CODI_UNUSED(endIndexPos);
+#else
+      size_t prefetchPos = indexPos;
+#endif
 
       while(stmtPos > endStmtPos) {
         --stmtPos;
@@ -416,9 +594,14 @@ namespace codi {
 
           HandleFactory::template callHandle<PrimalValueIndexTape<TapeTypes> >(statements[stmtPos], 1.0, passiveActiveReal[stmtPos], indexPos, indices, constantPos, constants, primalVector, adjointData);
 #else
+          if(0 != PrefetchDistance && stmtPos >= endStmtPos + PrefetchDistance) {
+            CODI_PREFETCH(&adjointData[lhsIndices[stmtPos - PrefetchDistance]]);
+          }
+
           const GradientValue adj = adjointData[lhsIndex];
           adjointData[lhsIndex] = GradientValue();
 
+          prefetchAdjointsReverse(adjointData, indices, prefetchPos, indexPos, endIndexPos);
           HandleFactory::template callHandle<PrimalValueIndexTape<TapeTypes> >(statements[stmtPos], adj, passiveActiveReal[stmtPos], indexPos, indices, constantPos, constants, primalVector, adjointData);
 #endif
       }
@@ -679,6 +862,7 @@ namespace codi {
     CODI_INLINE void evaluatePreacc(const Position& start, const Position& end) {
 
       resizeAdjointsToIndexSize();
+      dirtyAdjoints.addRange(*this, start, end);
 
       evaluateInt(start, end, adjoints, false);
 
@@ -713,6 +897,7 @@ namespace codi {
     CODI_INLINE void evaluateForwardPreacc(const Position& start, const Position& end) {
 
       resizeAdjointsToIndexSize();
+      dirtyAdjoints.addRange(*this, end, start);
 
       resetPrimalValues(start);
 
@@ -809,7 +994,7 @@ namespace codi {
    * @brief The instantiation of the index manager for the primal index tapes.
    */
   template <typename TapeTypes>
-  typename TapeTypes::IndexHandler PrimalValueIndexTape<TapeTypes>::indexHandler(MaxStatementIntSize - 1);
+  CODI_TAPE_STORAGE typename TapeTypes::IndexHandler PrimalValueIndexTape<TapeTypes>::indexHandler(MaxStatementIntSize - 1);
 
   #include "modules/primalValueStaticModule.tpp"
   #undef TAPE_NAME
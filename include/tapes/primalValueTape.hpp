@@ -35,12 +35,16 @@
 #include "../activeReal.hpp"
 #include "../expressionHandle.hpp"
 #include "chunkVector.hpp"
+#include "adjointPageWindow.hpp"
+#include "dirtyAdjointRange.hpp"
 #include "indices/linearIndexHandler.hpp"
 #include "handles/functionHandleFactory.hpp"
 #include "primalTapeExpressions.hpp"
 #include "reverseTapeInterface.hpp"
 #include "singleChunkVector.hpp"
+#include "zeroPageArray.hpp"
 #include "../tapeTypes.hpp"
+#include "../tools/blockAdjoint.hpp"
 #include "../tools/tapeValues.hpp"
 
 namespace codi {
@@ -141,6 +145,9 @@ namespace codi {
     /** @brief This tape requires no special primal value handling since the primal value vector is not overwritten. */
     static const bool RequiresPrimalReset = false;
 
+    /** @brief The evaluation only reads the tape. It can be evaluated by several threads with different adjoint vectors. */
+    static const bool AllowConcurrentEvaluation = true;
+
     #define TAPE_NAME PrimalValueTape
 
     #define POSITION_TYPE typename TapeTypes::Position
@@ -166,7 +173,6 @@ namespace codi {
 
     // TAPE_NAME is undefined at the end of the file
 
-
   public:
     /**
      * @brief Creates a tape with the size of zero for the data, statements and external functions.
@@ -175,6 +181,7 @@ namespace codi {
       indexHandler(MaxStatementIntSize - 1),
       /* defined in tapeBaseModule */adjoints(NULL),
       /* defined in tapeBaseModule */adjointsSize(0),
+      /* defined in tapeBaseModule */dirtyAdjoints(),
       /* defined in tapeBaseModule */active(false),
       /* defined in the primalValueModule */stmtVector(DefaultChunkSize, &indexHandler),
       /* defined in the primalValueModule */indexVector(DefaultChunkSize, &stmtVector),
@@ -187,6 +194,7 @@ namespace codi {
     /** @brief Tear down the tape. Delete all values from the modules */
     ~PrimalValueTape() {
       cleanTapeBase();
+      cleanPrimalValueModule();
     }
 
     /**
@@ -216,14 +224,49 @@ namespace codi {
      */
     CODI_INLINE void clearAdjoints(const Position& start, const Position& end) {
 
-      Index startPos = min(end.inner.inner.inner.inner, adjointsSize - 1);
-      Index endPos = min(start.inner.inner.inner.inner, adjointsSize - 1);
+      Index startPos = min((Index)(end.inner.inner.inner.inner + 1), adjointsSize);
+      Index endPos = min((Index)(start.inner.inner.inner.inner + 1), adjointsSize);
 
-      for(Index i = startPos + 1; i <= endPos; ++i) {
+      for(Index i = startPos; i < endPos; ++i) {
         adjoints[i] = GradientValue();
       }
     }
 
+    /**
+     * @brief Call the function for each index of the adjoint vector that an evaluation of the range accesses.
+     *
+     * The function is called for the left hand side and the arguments of all statements in the range. An index can
+     * be reported several times. Ranges with external functions are not inspected, since the external functions
+     * can access arbitrary adjoint values.
+     *
+     * It has to hold start >= end.
+     *
+     * @param[in]    start  The start of the range.
+     * @param[in]      end  The end of the range.
+     * @param[in,out] func  The function which is called with each index.
+     *
+     * @return false if the range contains external functions. The function is not called in this case.
+     *
+     * @tparam Func  Needs to be callable with an Index.
+     */
+    template<typename Func>
+    bool forEachAdjointIndex(const Position& start, const Position& end, Func& func) {
+      if(start.chunk != end.chunk || start.data != end.data) {
+        return false;
+      }
+
+      for(Index index = end.inner.inner.inner.inner + 1; index <= start.inner.inner.inner.inner; ++index) {
+        func(index);
+      }
+
+      auto argFunc = [&func] (Index* index) {
+        func(*index);
+      };
+      indexVector.forEachReverse(start.inner.inner, end.inner.inner, argFunc);
+
+      return true;
+    }
+
     /**
      * @brief Allocates a copy of the primal vector that is used in the evaluation.
      *
@@ -254,17 +297,29 @@ namespace codi {
       AdjVecType* adjVec = adjointData;
 #endif
 
-      auto evalFunc = [this] (const size_t& startAdjPos, const size_t& endAdjPos,
+      // the window is local to the evaluation, evaluations with other adjoint vectors do not modify the tape
+      AdjointPageWindow<GradientValue> adjointWindow(adjoints, (size_t)start.inner.inner.inner.inner);
+      AdjointPageWindow<GradientValue>* window = NULL;
+      if(AdjointPageWindow<GradientValue>::isApplicable(adjoints, adjointData)) {
+        window = &adjointWindow;
+      }
+
+      auto evalFunc = [this, window] (const size_t& startAdjPos, const size_t& endAdjPos,
                               AdjVecType* adjointData,
                               size_t& constantPos, const size_t& endConstantPos, PassiveReal* &constants,
                               size_t& indexPos, const size_t& endIndexPos, Index* &indices,
                               size_t& stmtPos, const size_t& endStmtPos,
                                 Handle* &statements, StatementInt* &passiveActiveReal) {
         evaluateStackReverse<AdjVecType>(startAdjPos, endAdjPos, adjointData, constantPos, endConstantPos, constants,
-                                     indexPos, endIndexPos, indices, stmtPos, endStmtPos, statements, passiveActiveReal);
+                                     indexPos, endIndexPos, indices, stmtPos, endStmtPos, statements, passiveActiveReal, window);
       };
       auto reverseFunc = &ConstantValueVector::template evaluateReverse<decltype(evalFunc), AdjVecType*&>;
+
       evaluateExtFunc(start, end, reverseFunc, constantValueVector, &interface, evalFunc, adjVec);
+
+      if(NULL != window) {
+        window->finish((size_t)end.inner.inner.inner.inner);
+      }
     }
 
     /**
@@ -402,6 +457,7 @@ namespace codi {
      * @param[in,out]       stmtPos  The current position in the statement data. It will decremented in the method.
      * @param[in]        statements  The vector with the handles for each statement.
      * @param[in] passiveActiveReal  The number passive values for each statement.
+     * @param[in,out]        window  The window which releases the adjoint pages. NULL if no pages are released.
      *
      * @tparam AdjointData The data for the adjoint vector it needs to support add, multiply and comparison operations.
      */
@@ -410,10 +466,14 @@ namespace codi {
                                           size_t& constantPos, const size_t& endConstPos, PassiveReal* &constants,
                                           size_t& indexPos, const size_t& endIndexPos, Index* &indices,
                                           size_t& stmtPos, const size_t& endStmtPos, Handle* &statements,
-                                          StatementInt* &passiveActiveReal) {
+                                          StatementInt* &passiveActiveReal, AdjointPageWindow<GradientValue>* window) {
       CODI_UNUSED(endConstPos);
-      CODI_UNUSED(endIndexPos);
       CODI_UNUSED(endStmtPos);
+#if CODI_EnableVariableAdjointInterfaceInPrimalTapes
+      CODI_UNUSED(endIndexPos);
+#else
+      size_t prefetchPos = indexPos;
+#endif
 
       size_t adjPos = startAdjPos;
 
@@ -432,10 +492,15 @@ namespace codi {
 #endif
         --adjPos;
 
+        if(AdjointPageWindow<GradientValue>::Enabled && NULL != window) {
+          window->evaluated(adjPos + 1, StatementIntInputTag == passiveActiveReal[stmtPos]);
+        }
+
         if(StatementIntInputTag != passiveActiveReal[stmtPos]) {
 #if CODI_EnableVariableAdjointInterfaceInPrimalTapes
           HandleFactory::template callHandle<PrimalValueTape<TapeTypes> >(statements[stmtPos], 1.0, passiveActiveReal[stmtPos], indexPos, indices, constantPos, constants, primals, adjointData);
 #else
+          prefetchAdjointsReverse(adjointData, indices, prefetchPos, indexPos, endIndexPos);
           HandleFactory::template callHandle<PrimalValueTape<TapeTypes> >(statements[stmtPos], adj, passiveActiveReal[stmtPos], indexPos, indices, constantPos, constants, primals, adjointData);
 #endif
         }
@@ -244,6 +244,16 @@ namespace codi {
       return chunk.getUsedSize();
     }
 
+    /**
+     * @brief Set the pointers of the handle to the data items at a position in the current chunk.
+     *
+     * @param[in]     pos  The position inside the data of the current chunk.
+     * @param[out] handle  The handle which is set to the data items.
+     */
+    CODI_INLINE void getDataPointer(const size_t& pos, PointerHandle<ChunkType>& handle) {
+      handle.setPointers(pos, &chunk);
+    }
+
     /**
      * @brief Get the position of the chunk vector and the nested vectors.
      * @return The position of the chunk vector.
@@ -341,6 +351,27 @@ namespace codi {
       forEachDataReverse(start.data, end.data, function, std::forward<Args>(args)...);
     }
 
+    /**
+     * @brief Iterates over all data entries in the given range, the function can modify the data.
+     *
+     * The same as forEachReverse but the chunk is marked as modified.
+     *
+     * It has to hold start >= end.
+     *
+     * @param    start  The starting point of the range.
+     * @param      end  The end point of the range.
+     * @param function  The function called for each data entry.
+     * @param     args  Additional arguments for the function
+     *
+     * @tparam  Args  The data types for the arguments.
+     */
+    template<typename FunctionObject, typename ... Args>
+    CODI_INLINE void modifyEachReverse(const Position& start, const Position& end, FunctionObject& function, Args &&... args) {
+      chunk.setModified();
+
+      forEachReverse(start, end, function, std::forward<Args>(args)...);
+    }
+
     /**
      * @brief Iterates over the chunk of the vector.
      *
@@ -402,6 +433,30 @@ namespace codi {
       pHandle.callNestedReverse(nested, start.inner, end.inner, function, std::forward<Args>(args)..., dataPos, end.data);
     }
 
+    /**
+     * @brief Reverse stack evaluation of the tape which can skip whole chunks.
+     *
+     * The vector has only one chunk which is always evaluated. The skip function is not called.
+     *
+     * The other arguments are the same as for evaluateReverse. It has to hold start >= end.
+     *
+     * @param    start  The start point for the stack interpretation.
+     * @param      end  The end point for the stack interpretation.
+     * @param     skip  Not used.
+     * @param function  The function called for each valid range.
+     * @param     args  Pointers and ranges from other chunks vectors and additional arguments for the
+     *                  function.
+     *
+     * @tparam  Args  The data types for the arguments.
+     */
+    template<typename Skip, typename Function, typename ... Args>
+    CODI_INLINE void evaluateReverseSkip(const Position& start, const Position& end, const Skip& skip,
+                                         const Function& function, Args&&... args) {
+      CODI_UNUSED(skip);
+
+      evaluateReverse(start, end, function, std::forward<Args>(args)...);
+    }
+
     /**
      * @brief Forward stack evaluation of the tape.
      *
@@ -0,0 +1,821 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <stdio.h>
+#include <typeindex>
+#include <typeinfo>
+
+#include "../configure.h"
+#include "../tools/io.hpp"
+#include "chunk.hpp"
+#include "chunkVector.hpp"
+#include "pointerHandle.hpp"
+
+#if CODI_EnableSwapChunkPrefetch
+  #include <condition_variable>
+  #include <deque>
+  #include <future>
+  #include <mutex>
+  #include <thread>
+#endif
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  struct SwapChunkStorage;
+
+  /**
+   * @brief The interface of the chunks that can be swapped to a scratch file by the SwapChunkStorage.
+   */
+  struct SwapChunkBase {
+
+    /** @brief If the chunk is in the list of the swap candidates. */
+    bool isCandidate;
+
+    /** @brief The position of the chunk in the list of the swap candidates. */
+    std::list<SwapChunkBase*>::iterator candidatePos;
+
+    /**
+     * @brief The chunk is not a swap candidate.
+     */
+    SwapChunkBase() :
+      isCandidate(false),
+      candidatePos() {}
+
+    /**
+     * @brief Destructor for the swap interface.
+     */
+    virtual ~SwapChunkBase() {}
+
+    /**
+     * @brief Write the data of the chunk to the scratch file and release the memory.
+     *
+     * @param[in,out] storage  The storage which manages the scratch file.
+     */
+    virtual void swapOut(SwapChunkStorage& storage) = 0;
+  };
+
+  /**
+   * @brief Management of the scratch file and the memory budget for all swap chunks.
+   *
+   * The storage counts the memory of all swap chunks which have their data in memory. Chunks
+   * which are no longer directly needed by the tape are added as swap candidates. If the memory
+   * budget is exceeded, the candidates are swapped out in the order in which they were added until
+   * the memory is below the budget again. Chunks which are currently used for the recording or
+   * the evaluation are never candidates, therefore the budget can be exceeded by these chunks.
+   *
+   * The scratch file is created with tmpfile on the first swap out. It is removed by the operating
+   * system when the program terminates. Each chunk gets one slot in the file, released slots are
+   * reused by other chunks of the same size.
+   *
+   * If CODI_EnableSwapChunkPrefetch is set, the chunks can be read by a background thread. The storage starts one
+   * worker thread on the first prefetch, which reads the chunks in the order of the requests. The worker is also used
+   * by the CompressedChunk2 to decode its data. All accesses to
+   * the scratch file are then guarded by a mutex. A prefetched chunk is not a candidate until it has been loaded
+   * and stored again. The storage keeps one pending prefetch per chunk type, that is one for each data vector of a
+   * tape. If a chunk is not loaded before the next chunk of its type is prefetched, e.g. because the evaluation
+   * skipped it, it becomes a candidate at that point.
+   *
+   * All swap chunks use the global storage, which is created with the budget DefaultSwapChunkMemory. The storage
+   * itself is not guarded for the access from several threads. If CODI_ThreadLocalTape is set, each thread has its own
+   * global storage with its own budget, scratch file and worker thread.
+   */
+  struct SwapChunkStorage {
+    private:
+
+      FILE* fileHandle; /**< The handle for the scratch file. */
+      long fileSize; /**< The number of bytes reserved in the scratch file. */
+
+      std::multimap<size_t, long> freeSlots; /**< Released slots in the file. Maps the size to the offset. */
+      std::list<SwapChunkBase*> candidates; /**< The chunks that can be swapped out. */
+
+      size_t memoryBudget; /**< The number of bytes the chunks can keep in memory. */
+      size_t memoryUsed; /**< The number of bytes the chunks currently have in memory. */
+
+      std::map<std::type_index, SwapChunkBase*> prefetched; /**< The last prefetched chunk of each chunk type if it has not been loaded yet. */
+
+#if CODI_EnableSwapChunkPrefetch
+      std::mutex fileMutex; /**< Guards the accesses to the scratch file. */
+
+      std::thread worker; /**< The thread that reads the prefetched chunks. Started on the first prefetch. */
+      std::mutex taskMutex; /**< Guards the task queue of the worker. */
+      std::condition_variable taskCondition; /**< Signals new tasks and the stop to the worker. */
+      std::deque<std::packaged_task<void()> > tasks; /**< The pending reads of the worker. */
+      bool stopWorker; /**< If the worker should finish after the pending reads. */
+#endif
+
+    public:
+
+      /**
+       * @brief Create an empty storage with the default budget.
+       */
+      SwapChunkStorage() :
+        fileHandle(NULL),
+        fileSize(0),
+        freeSlots(),
+        candidates(),
+        memoryBudget(DefaultSwapChunkMemory),
+        memoryUsed(0),
+        prefetched()
+#if CODI_EnableSwapChunkPrefetch
+        , fileMutex()
+        , worker()
+        , taskMutex()
+        , taskCondition()
+        , tasks()
+        , stopWorker(false)
+#endif
+      {}
+
+      /**
+       * @brief Stops the worker thread and closes the scratch file.
+       */
+      ~SwapChunkStorage() {
+#if CODI_EnableSwapChunkPrefetch
+        {
+          std::lock_guard<std::mutex> lock(taskMutex);
+          stopWorker = true;
+        }
+        taskCondition.notify_one();
+        if(worker.joinable()) {
+          worker.join();
+        }
+#endif
+
+        if(NULL != fileHandle) {
+          fclose(fileHandle);
+        }
+      }
+
+      /**
+       * @brief The storage which is used by all swap chunks of the current thread.
+       *
+       * The storage is shared by all threads unless CODI_ThreadLocalTape is set.
+       *
+       * @return The global storage.
+       */
+      static SwapChunkStorage& getGlobal() {
+        static CODI_TAPE_STORAGE SwapChunkStorage storage;
+
+        return storage;
+      }
+
+      /**
+       * @brief Set the number of bytes the swap chunks can keep in memory.
+       *
+       * Candidates are swapped out immediately if the new budget is exceeded.
+       *
+       * @param[in] budget  The new budget in bytes.
+       */
+      void setMemoryBudget(const size_t& budget) {
+        memoryBudget = budget;
+
+        enforceBudget();
+      }
+
+      /**
+       * @brief Get the number of bytes the swap chunks can keep in memory.
+       *
+       * @return The budget in bytes.
+       */
+      size_t getMemoryBudget() const {
+        return memoryBudget;
+      }
+
+      /**
+       * @brief Get the number of bytes the swap chunks currently have in memory.
+       *
+       * @return The used memory in bytes.
+       */
+      size_t getMemoryUsed() const {
+        return memoryUsed;
+      }
+
+      /**
+       * @brief Get the number of bytes which are reserved in the scratch file.
+       *
+       * @return The size of the scratch file in bytes.
+       */
+      size_t getFileSize() const {
+        return (size_t)fileSize;
+      }
+
+      /**
+       * @brief Add the memory of a chunk which has loaded its data.
+       *
+       * @param[in] bytes  The memory of the chunk in bytes.
+       */
+      void addMemory(const size_t& bytes) {
+        memoryUsed += bytes;
+      }
+
+      /**
+       * @brief Remove the memory of a chunk which has released its data.
+       *
+       * @param[in] bytes  The memory of the chunk in bytes.
+       */
+      void removeMemory(const size_t& bytes) {
+        codiAssert(bytes <= memoryUsed);
+
+        memoryUsed -= bytes;
+      }
+
+      /**
+       * @brief Mark the chunk as a candidate for the swap out.
+       *
+       * @param[in,out] chunk  The chunk which is no longer directly needed.
+       */
+      void addCandidate(SwapChunkBase* chunk) {
+        if(!chunk->isCandidate) {
+          chunk->candidatePos = candidates.insert(candidates.end(), chunk);
+          chunk->isCandidate = true;
+        }
+      }
+
+      /**
+       * @brief Remove the chunk from the candidates for the swap out.
+       *
+       * @param[in,out] chunk  The chunk which is needed again.
+       */
+      void removeCandidate(SwapChunkBase* chunk) {
+        if(chunk->isCandidate) {
+          candidates.erase(chunk->candidatePos);
+          chunk->isCandidate = false;
+        }
+      }
+
+      /**
+       * @brief Remember the chunk as the last prefetched one of its type.
+       *
+       * A previously prefetched chunk of the same type that has not been loaded is added to the candidates.
+       *
+       * @param[in,out] chunk  The chunk which is read in the background.
+       */
+      void addPrefetch(SwapChunkBase* chunk) {
+        SwapChunkBase*& pending = prefetched[std::type_index(typeid(*chunk))];
+        if(NULL != pending && chunk != pending) {
+          addCandidate(pending);
+        }
+
+        pending = chunk;
+      }
+
+      /**
+       * @brief Forget the chunk as the last prefetched one of its type.
+       *
+       * @param[in] chunk  The chunk which is loaded or deleted.
+       */
+      void removePrefetch(SwapChunkBase* chunk) {
+        std::map<std::type_index, SwapChunkBase*>::iterator pos = prefetched.find(std::type_index(typeid(*chunk)));
+        if(prefetched.end() != pos && chunk == pos->second) {
+          pos->second = NULL;
+        }
+      }
+
+      /**
+       * @brief Swap out candidates until the used memory is below the budget.
+       */
+      void enforceBudget() {
+        while(memoryUsed > memoryBudget && !candidates.empty()) {
+          SwapChunkBase* chunk = candidates.front();
+          removeCandidate(chunk);
+
+          chunk->swapOut(*this);
+        }
+      }
+
+      /**
+       * @brief Reserve a slot in the scratch file.
+       *
+       * @param[in] bytes  The size of the slot in bytes.
+       *
+       * @return The offset of the slot in the file.
+       */
+      long acquireSlot(const size_t& bytes) {
+        std::multimap<size_t, long>::iterator pos = freeSlots.find(bytes);
+        if(freeSlots.end() != pos) {
+          long offset = pos->second;
+          freeSlots.erase(pos);
+
+          return offset;
+        } else {
+          long offset = fileSize;
+          fileSize += (long)bytes;
+
+          return offset;
+        }
+      }
+
+      /**
+       * @brief Release a slot in the scratch file such that it can be used by other chunks.
+       *
+       * @param[in] offset  The offset of the slot in the file.
+       * @param[in]  bytes  The size of the slot in bytes.
+       */
+      void releaseSlot(const long& offset, const size_t& bytes) {
+        freeSlots.insert(std::make_pair(bytes, offset));
+      }
+
+      /**
+       * @brief Write the data of the chunk into its slot in the scratch file.
+       *
+       * The io method of the memory chunk is called directly.
+       *
+       * @param[in] offset  The offset of the slot in the file.
+       * @param[in]  chunk  The chunk with the data.
+       *
+       * @tparam Chunk  The memory chunk which holds the data.
+       */
+      template<typename Chunk>
+      void writeChunk(const long& offset, const Chunk& chunk) {
+#if CODI_EnableSwapChunkPrefetch
+        std::lock_guard<std::mutex> lock(fileMutex);
+#endif
+        CoDiIoHandle handle(getFile(), offset, true);
+
+        chunk.Chunk::writeData(handle);
+      }
+
+      /**
+       * @brief Read the data of the chunk from its slot in the scratch file.
+       *
+       * The io method of the memory chunk is called directly.
+       *
+       * @param[in]     offset  The offset of the slot in the file.
+       * @param[in,out]  chunk  The chunk for the data.
+       *
+       * @tparam Chunk  The memory chunk which holds the data.
+       */
+      template<typename Chunk>
+      void readChunk(const long& offset, Chunk& chunk) {
+#if CODI_EnableSwapChunkPrefetch
+        std::lock_guard<std::mutex> lock(fileMutex);
+#endif
+        CoDiIoHandle handle(getFile(), offset, false);
+
+        chunk.Chunk::readData(handle);
+      }
+
+#if CODI_EnableSwapChunkPrefetch
+      /**
+       * @brief Read the data of the chunk in the worker thread.
+       *
+       * The worker thread is started on the first call.
+       *
+       * @param[in]     offset  The offset of the slot in the file.
+       * @param[in,out]  chunk  The chunk for the data. The data has to be allocated.
+       *
+       * @return The result of the read. Errors are reported when the result is queried.
+       *
+       * @tparam Chunk  The memory chunk which holds the data.
+       */
+      template<typename Chunk>
+      std::future<void> readChunkAsync(const long& offset, Chunk& chunk) {
+        Chunk* chunkPointer = &chunk;
+
+        return runAsync([this, offset, chunkPointer]() {
+          readChunk(offset, *chunkPointer);
+        });
+      }
+
+      /**
+       * @brief Run the function in the worker thread after all pending tasks.
+       *
+       * The worker thread is started on the first call.
+       *
+       * @param[in] func  The function object without arguments.
+       *
+       * @return The result of the function. Errors are reported when the result is queried.
+       *
+       * @tparam Func  The type of the function object.
+       */
+      template<typename Func>
+      std::future<void> runAsync(const Func& func) {
+        std::packaged_task<void()> task(func);
+        std::future<void> result = task.get_future();
+
+        {
+          std::lock_guard<std::mutex> lock(taskMutex);
+          if(!worker.joinable()) {
+            worker = std::thread(&SwapChunkStorage::runWorker, this);
+          }
+          tasks.push_back(std::move(task));
+        }
+        taskCondition.notify_one();
+
+        return result;
+      }
+#endif
+
+    private:
+
+#if CODI_EnableSwapChunkPrefetch
+      /**
+       * @brief The loop of the worker thread. Runs the reads until the storage is destroyed.
+       */
+      void runWorker() {
+        std::unique_lock<std::mutex> lock(taskMutex);
+        while(true) {
+          taskCondition.wait(lock, [this]() { return stopWorker || !tasks.empty(); });
+          if(tasks.empty()) {
+            break; // stop was requested and all reads are done
+          }
+
+          std::packaged_task<void()> task = std::move(tasks.front());
+          tasks.pop_front();
+
+          lock.unlock();
+          task();
+          lock.lock();
+        }
+      }
+#endif
+
+      /**
+       * @brief Get the handle of the scratch file. The file is created on the first call.
+       *
+       * @return The handle of the scratch file.
+       */
+      FILE* getFile() {
+        if(NULL == fileHandle) {
+          fileHandle = tmpfile();
+
+          if(NULL == fileHandle) {
+            throw IoException(IoError::Open , "Could not create the scratch file for the swap chunks.", true);
+          }
+        }
+
+        return fileHandle;
+      }
+  };
+
+  /**
+   * @brief Chunk which writes its data to a scratch file if the memory budget is exceeded.
+   *
+   * The chunk extends one of the memory chunks Chunk1, Chunk2, Chunk3 or Chunk4. The ChunkVector
+   * calls store if it leaves the chunk and load if it needs the data of the chunk again. A stored chunk
+   * is a candidate for the swap out in the global SwapChunkStorage of the thread which created the chunk. The chunk
+   * keeps using this storage if it is evaluated by another thread, e.g. with the TapeJoinHelper. If the chunk is
+   * loaded again, the data is read back from the scratch file.
+   *
+   * The data is only written again if it was changed after the last swap out. Each chunk keeps its
+   * slot in the scratch file until it is deleted.
+   *
+   * If CODI_EnableSwapChunkPrefetch is set, prefetch starts the reading of the data in the worker thread of the
+   * storage. The following load waits until the data is available.
+   *
+   * @tparam Chunk  The memory chunk which holds the data. Needs to implement the ChunkInterface.
+   */
+  template<typename Chunk>
+  struct SwapChunk final : public Chunk, public SwapChunkBase {
+
+    /** @brief The memory chunk which holds the data. */
+    typedef Chunk BaseChunk;
+
+    /** @brief The data is read and released during the evaluation. */
+    static const bool ConcurrentRead = false;
+
+    bool resident; /**< If the data of the chunk is in memory. */
+    bool onDisk; /**< If the scratch file contains the data of the chunk. */
+    bool dirty; /**< If the data was changed since it was written to the scratch file. */
+    long fileOffset; /**< The offset of the slot in the scratch file. -1 if no slot was acquired. */
+    size_t slotSize; /**< The size of the slot in the scratch file in bytes. */
+
+    SwapChunkStorage* swapStorage; /**< The storage which manages the memory and the slot of the chunk. */
+
+#if CODI_EnableSwapChunkPrefetch
+    mutable std::future<void> prefetchResult; /**< The result of the background read of the data. */
+#endif
+
+    /**
+     * @brief Creates the data of the chunk.
+     *
+     * @param size The size of the data in the chunk.
+     */
+    SwapChunk(const size_t& size) :
+      Chunk(size),
+      SwapChunkBase(),
+      resident(true),
+      onDisk(false),
+      dirty(true),
+      fileOffset(-1),
+      slotSize(0),
+      swapStorage(&SwapChunkStorage::getGlobal())
+#if CODI_EnableSwapChunkPrefetch
+      , prefetchResult()
+#endif
+    {
+      swapStorage->addMemory(getMemorySize());
+      swapStorage->enforceBudget();
+    }
+
+    /**
+     * @brief Releases the memory and the slot in the scratch file.
+     */
+    ~SwapChunk() {
+      SwapChunkStorage& storage = *swapStorage;
+
+#if CODI_EnableSwapChunkPrefetch
+      if(prefetchResult.valid()) {
+        prefetchResult.wait(); // errors can not be reported in the destructor
+      }
+#endif
+
+      storage.removePrefetch(this);
+      storage.removeCandidate(this);
+      if(resident) {
+        storage.removeMemory(getMemorySize());
+        resident = false;
+      }
+      if(-1 != fileOffset) {
+        storage.releaseSlot(fileOffset, slotSize);
+      }
+    }
+
+    /**
+     * @brief The number of bytes the data of the chunk needs in memory and in the scratch file.
+     *
+     * @return The size of the data in bytes.
+     */
+    CODI_INLINE size_t getMemorySize() const {
+      return this->size * Chunk::EntrySize;
+    }
+
+    /**
+     * @brief Write all the data of the chunk to the io handle.
+     *
+     * If the chunk is swapped out, the data is taken directly from the scratch file.
+     *
+     * @param[in,out] handle  The handle for the io operations.
+     */
+    void writeData(CoDiIoHandle& handle) const {
+      waitForPrefetch();
+
+      if(resident || !onDisk) {
+        Chunk::writeData(handle);
+      } else {
+        Chunk temp(this->size);
+        swapStorage->readChunk(fileOffset, temp);
+        temp.writeData(handle);
+      }
+    }
+
+    /**
+     * @brief Read the data for the chunk from the io handle.
+     *
+     * The method ensures that the data is allocated. The data in the scratch file is no longer valid.
+     *
+     * @param[in,out] handle  The handle for the io operations.
+     */
+    void readData(CoDiIoHandle& handle) {
+      waitForPrefetch();
+
+      Chunk::readData(handle);
+
+      onDisk = false;
+      dirty = true;
+    }
+
+    /**
+     * @brief Ensures that the data for the chunk is allocated.
+     */
+    void allocateData() {
+      if(!resident) {
+        Chunk::allocateData();
+
+        resident = true;
+        swapStorage->addMemory(getMemorySize());
+      }
+    }
+
+    /**
+     * @brief Deletes the data of the chunk.
+     */
+    void deleteData() {
+      waitForPrefetch();
+
+      if(resident) {
+        swapStorage->removePrefetch(this);
+        swapStorage->removeCandidate(this);
+        Chunk::deleteData();
+
+        resident = false;
+        swapStorage->removeMemory(getMemorySize());
+      }
+    }
+
+    /**
+     * @brief Set the size of the arrays.
+     *
+     * The data is allocated with the new size and the chunk is empty afterwards. The slot in the scratch file is kept if
+     * the new data fits into it.
+     *
+     * @param size  The new size of the arrays.
+     */
+    void resize(const size_t &size) {
+      waitForPrefetch();
+
+      swapStorage->removePrefetch(this);
+      swapStorage->removeCandidate(this);
+      if(resident) {
+        Chunk::deleteData();
+        swapStorage->removeMemory(getMemorySize());
+      }
+
+      this->size = size;
+      this->usedSize = 0;
+
+      Chunk::allocateData();
+      resident = true;
+      onDisk = false;
+      dirty = true;
+      swapStorage->addMemory(getMemorySize());
+
+      if(-1 != fileOffset && getMemorySize() > slotSize) {
+        swapStorage->releaseSlot(fileOffset, slotSize);
+        fileOffset = -1;
+      }
+
+      swapStorage->enforceBudget();
+    }
+
+    /**
+     * @brief Fully reset the data in this chunk.
+     *
+     * The data in the scratch file is no longer valid.
+     */
+    CODI_INLINE void reset() {
+      Chunk::reset();
+
+      onDisk = false;
+      dirty = true;
+    }
+
+    /**
+     * @brief Set the number of used items in this chunk.
+     *
+     * The data is marked as changed.
+     *
+     * @param usage   The number of used items.
+     */
+    CODI_INLINE void setUsedSize(const size_t& usage) {
+      Chunk::setUsedSize(usage);
+
+      dirty = true;
+    }
+
+    /**
+     * @brief Mark the data of the chunk as changed.
+     */
+    CODI_INLINE void setModified() {
+      dirty = true;
+    }
+
+    /**
+     * @brief Mark the chunk as a candidate for the swap out.
+     */
+    void store() {
+      SwapChunkStorage& storage = *swapStorage;
+
+      if(resident) {
+        storage.addCandidate(this);
+        storage.enforceBudget();
+      }
+    }
+
+    /**
+     * @brief Ensure that the data of the chunk is in memory.
+     *
+     * The chunk is no longer a candidate for the swap out until store is called.
+     */
+    void load() {
+      SwapChunkStorage& storage = *swapStorage;
+
+      waitForPrefetch();
+
+      storage.removePrefetch(this);
+      storage.removeCandidate(this);
+      if(!resident) {
+        allocateData();
+
+        if(onDisk) {
+          storage.readChunk(fileOffset, *static_cast<Chunk*>(this));
+          dirty = false;
+        }
+
+        storage.enforceBudget();
+      }
+    }
+
+    /**
+     * @brief Start the reading of the data in the worker thread of the storage.
+     *
+     * The chunk is not a candidate for the swap out, it becomes one after it was loaded and stored. Other candidates
+     * are swapped out if the data exceeds the budget. Without CODI_EnableSwapChunkPrefetch the method does nothing.
+     */
+    void prefetch() {
+#if CODI_EnableSwapChunkPrefetch
+      SwapChunkStorage& storage = *swapStorage;
+
+      if(!resident && onDisk) {
+        allocateData();
+        dirty = false;
+
+        prefetchResult = storage.readChunkAsync(fileOffset, *static_cast<Chunk*>(this));
+
+        storage.addPrefetch(this);
+        storage.enforceBudget();
+      }
+#endif
+    }
+
+    /**
+     * @brief Wait until the background read of the data is finished.
+     *
+     * Errors of the read are reported here. Without CODI_EnableSwapChunkPrefetch the method does nothing.
+     */
+    CODI_INLINE void waitForPrefetch() const {
+#if CODI_EnableSwapChunkPrefetch
+      if(prefetchResult.valid()) {
+        prefetchResult.get();
+      }
+#endif
+    }
+
+    /**
+     * @brief Write the data to the scratch file if it was changed and release the memory.
+     *
+     * @param[in,out] storage  The storage which manages the scratch file.
+     */
+    void swapOut(SwapChunkStorage& storage) {
+      codiAssert(resident);
+
+      waitForPrefetch();
+
+      if(dirty || !onDisk) {
+        if(-1 == fileOffset) {
+          slotSize = getMemorySize();
+          fileOffset = storage.acquireSlot(slotSize);
+        }
+
+        storage.writeChunk(fileOffset, *static_cast<const Chunk*>(this));
+        onDisk = true;
+        dirty = false;
+      }
+
+      deleteData();
+    }
+  };
+
+  /**
+   * @brief Specialization for PointerHandle with a SwapChunk type.
+   *
+   * The pointers are set by the handle of the memory chunk.
+   *
+   * @tparam Chunk  The memory chunk of the swap chunk.
+   */
+  template<typename Chunk>
+  struct PointerHandle<SwapChunk<Chunk> > : public PointerHandle<Chunk> {};
+
+  /**
+   * @brief A chunk vector which uses swap chunks for its data.
+   *
+   * The vector can be used as the DataVector argument of the tape types, e.g. JacobiTapeTypes.
+   *
+   * @tparam    ChunkData  The memory chunk for the data of the swap chunks.
+   * @tparam NestedVector  A nested chunk vector used for position information.
+   */
+  template<typename ChunkData, typename NestedVector>
+  using SwapChunkVector = ChunkVector<SwapChunk<ChunkData>, NestedVector>;
+}
@@ -0,0 +1,454 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "../configure.h"
+#include "../macros.h"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Elimination of the intermediate variables of a recorded tape range.
+   *
+   * The statements of the range define a computational graph. An intermediate variable v with the
+   * predecessors p and the successors s is eliminated by adding the edges
+   *
+   * \f[ c_{s,p} = c_{s,p} + c_{s,v} c_{v,p} \f]
+   *
+   * and removing v from the graph. The variables are eliminated in the order of their Markowitz
+   * cost |p| |s|. A variable is only eliminated if the number of edges does not grow, that is
+   * |p| |s| <= |p| + |s|, and if the successors do not exceed the maximum number of arguments of a statement.
+   * Variables without successors are removed.
+   *
+   * A variable is only eliminated if the indices of its arguments are not overwritten before its successors, such
+   * that the successors can read the arguments directly. The outputs of the range, that is all variables which are
+   * used after the range, need to be added with addOutput before the elimination. Registered inputs are never
+   * eliminated.
+   *
+   * The remaining statements are stored in the order of the recording and are written to the tape again.
+   * For tapes with a linear index handler the remaining left hand sides get new indices. All active variables
+   * with an index of the range need to be updated with apply afterwards, e.g. the outputs.
+   *
+   * @tparam  Real  The floating point type of the Jacobies.
+   * @tparam Index  The type for the indices.
+   */
+  template<typename Real, typename Index>
+  struct VertexElimination {
+
+    std::vector<StatementInt> statements; /**< The number of arguments of each remaining statement or StatementIntInputTag */
+    std::vector<Index> lhsIndices; /**< The left hand side indices of the remaining statements */
+    std::vector<Index> argumentIndices; /**< The argument indices of the remaining statements */
+    std::vector<Real> jacobies; /**< The Jacobies of the arguments */
+    std::vector<Index> newIndices; /**< The new index for each old index, only used for linear index handlers */
+
+  private:
+
+    struct Edge {
+      size_t vertex; /**< The defining statement in the range or noVertex() */
+      Index index; /**< The index of the argument */
+      Real jacobi; /**< The Jacobi of the argument */
+    };
+
+    struct Vertex {
+      Index lhs;
+      Index newLhs;
+      bool input;
+      bool output;
+      bool removed;
+      size_t nextWrite; /**< The next statement with the same lhs index or noVertex() */
+      std::vector<Edge> preds;
+      std::vector<size_t> succs;
+    };
+
+    typedef std::pair<size_t, size_t> QueueEntry;
+
+    std::vector<Index> outputs;
+    std::vector<Vertex> vertices;
+    std::vector<size_t> firstWrite;
+    Index maxIndex;
+    bool renumber;
+    size_t removedCount;
+
+  public:
+
+    /**
+     * @brief Creates an empty elimination.
+     */
+    VertexElimination() :
+      statements(),
+      lhsIndices(),
+      argumentIndices(),
+      jacobies(),
+      newIndices(),
+      outputs(),
+      vertices(),
+      firstWrite(),
+      maxIndex(0),
+      renumber(false),
+      removedCount(0) {}
+
+    /**
+     * @brief Add a variable which is used after the range. Its statement is not eliminated.
+     *
+     * @param[in] index  The index of the variable.
+     */
+    void addOutput(const Index& index) {
+      if(0 != index) {
+        outputs.push_back(index);
+      }
+    }
+
+    /**
+     * @brief Remove all data including the outputs.
+     */
+    void clear() {
+      outputs.clear();
+      begin(0);
+      newIndices.clear();
+    }
+
+    /**
+     * @brief Remove the data of the previous range and start the collection of the statements of a new range.
+     *
+     * The outputs are kept.
+     *
+     * @param[in] maxIndex  The largest index used in the range.
+     */
+    void begin(const Index& maxIndex) {
+      this->maxIndex = maxIndex;
+      renumber = false;
+      removedCount = 0;
+
+      statements.clear();
+      lhsIndices.clear();
+      argumentIndices.clear();
+      jacobies.clear();
+      vertices.clear();
+    }
+
+    /**
+     * @brief Add a statement. The statements have to be added in the reverse order of the recording.
+     *
+     * The arguments of the statement are added afterwards with addArgument.
+     *
+     * @param[in]   lhs  The left hand side of the statement.
+     * @param[in] input  If the statement registers an input.
+     */
+    void addStatement(const Index& lhs, const bool input) {
+      codiAssert(lhs <= maxIndex);
+
+      vertices.push_back(Vertex());
+      Vertex& vertex = vertices.back();
+      vertex.lhs = lhs;
+      vertex.newLhs = lhs;
+      vertex.input = input;
+      vertex.output = false;
+      vertex.removed = false;
+      vertex.nextWrite = noVertex();
+    }
+
+    /**
+     * @brief Add an argument of the last added statement.
+     *
+     * @param[in]  index  The index of the argument.
+     * @param[in] jacobi  The Jacobi of the argument.
+     */
+    void addArgument(const Index& index, const Real& jacobi) {
+      codiAssert(index <= maxIndex);
+
+      Edge edge;
+      edge.vertex = noVertex();
+      edge.index = index;
+      edge.jacobi = jacobi;
+      vertices.back().preds.push_back(edge);
+    }
+
+    /**
+     * @brief Build the graph of the added statements, eliminate the intermediate variables and store the remaining statements.
+     *
+     * @param[in] firstIndex  The index before the range. Only used if renumber is set.
+     * @param[in]   renumber  If set, the remaining statements get the indices after firstIndex in their order, e.g.
+     *                        for linear index handlers.
+     */
+    void finalize(const Index& firstIndex, const bool renumber) {
+      this->renumber = renumber;
+
+      buildGraph();
+      eliminate();
+      storeStatements(firstIndex);
+
+      std::vector<Vertex>().swap(vertices);
+      std::vector<size_t>().swap(firstWrite);
+    }
+
+    /**
+     * @brief Get the number of eliminated statements.
+     *
+     * @return The number of statements which have been removed from the range.
+     */
+    size_t getRemovedCount() const {
+      return removedCount;
+    }
+
+    /**
+     * @brief Get the new number of an index.
+     *
+     * @param[in] index  The old index.
+     * @return The new index. It is zero if the statement of the index has been eliminated.
+     */
+    CODI_INLINE Index getNewIndex(const Index& index) const {
+      if(renumber && (size_t)index < newIndices.size()) {
+        return newIndices[index];
+      } else {
+        return index;
+      }
+    }
+
+    /**
+     * @brief Replace an index with its new number.
+     *
+     * @param[in,out] index  The index of an active variable.
+     */
+    CODI_INLINE void apply(Index& index) const {
+      index = getNewIndex(index);
+    }
+
+  private:
+
+    static size_t noVertex() {
+      return std::numeric_limits<size_t>::max();
+    }
+
+    void buildGraph() {
+      std::reverse(vertices.begin(), vertices.end());
+
+      firstWrite.assign((size_t)maxIndex + 1, noVertex());
+      std::vector<size_t> writer((size_t)maxIndex + 1, noVertex());
+      for(size_t v = 0; v < vertices.size(); ++v) {
+        Vertex& vertex = vertices[v];
+
+        // the arguments were added in the reverse order, duplicated arguments are merged
+        std::vector<Edge> args;
+        args.swap(vertex.preds);
+        for(size_t a = args.size(); a > 0; --a) {
+          Edge& edge = args[a - 1];
+          edge.vertex = writer[edge.index];
+          if(addEdge(vertex.preds, edge) && noVertex() != edge.vertex) {
+            vertices[edge.vertex].succs.push_back(v);
+          }
+        }
+
+        if(noVertex() == writer[vertex.lhs]) {
+          firstWrite[vertex.lhs] = v;
+        } else {
+          vertices[writer[vertex.lhs]].nextWrite = v;
+        }
+        writer[vertex.lhs] = v;
+      }
+
+      for(size_t o = 0; o < outputs.size(); ++o) {
+        if((size_t)outputs[o] < writer.size() && noVertex() != writer[outputs[o]]) {
+          vertices[writer[outputs[o]]].output = true;
+        }
+      }
+    }
+
+    static bool addEdge(std::vector<Edge>& edges, const Edge& edge) {
+      for(size_t e = 0; e < edges.size(); ++e) {
+        if(edges[e].vertex == edge.vertex && (noVertex() != edge.vertex || edges[e].index == edge.index)) {
+          edges[e].jacobi += edge.jacobi;
+
+          return false;
+        }
+      }
+
+      edges.push_back(edge);
+
+      return true;
+    }
+
+    size_t getCost(const size_t v) const {
+      return vertices[v].preds.size() * vertices[v].succs.size();
+    }
+
+    bool isIntermediate(const size_t v) const {
+      const Vertex& vertex = vertices[v];
+
+      return !vertex.removed && !vertex.input && !vertex.output;
+    }
+
+    bool canEliminate(const size_t v) const {
+      const Vertex& vertex = vertices[v];
+      const size_t predCount = vertex.preds.size();
+      const size_t succCount = vertex.succs.size();
+
+      if(predCount * succCount > predCount + succCount) {
+        return false;
+      }
+
+      for(size_t s = 0; s < succCount; ++s) {
+        if(vertices[vertex.succs[s]].preds.size() - 1 + predCount >= (size_t)MaxStatementIntSize) {
+          return false;
+        }
+      }
+
+      for(size_t p = 0; p < predCount; ++p) {
+        const Edge& edge = vertex.preds[p];
+
+        // the value of the argument needs to be available until the last successor
+        size_t overwrite = noVertex() == edge.vertex ? firstWrite[edge.index] : vertices[edge.vertex].nextWrite;
+        for(size_t s = 0; s < succCount; ++s) {
+          if(overwrite < vertex.succs[s]) {
+            return false;
+          }
+        }
+      }
+
+      return true;
+    }
+
+    void eliminate() {
+      std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > queue;
+      for(size_t v = 0; v < vertices.size(); ++v) {
+        if(isIntermediate(v)) {
+          queue.push(QueueEntry(getCost(v), v));
+        }
+      }
+
+      while(!queue.empty()) {
+        QueueEntry entry = queue.top();
+        queue.pop();
+
+        const size_t v = entry.second;
+        if(!isIntermediate(v) || entry.first != getCost(v) || !canEliminate(v)) {
+          // outdated entries are skipped, changed costs have been added again
+          continue;
+        }
+
+        std::vector<size_t> neighbours(vertices[v].succs);
+        for(size_t p = 0; p < vertices[v].preds.size(); ++p) {
+          if(noVertex() != vertices[v].preds[p].vertex) {
+            neighbours.push_back(vertices[v].preds[p].vertex);
+          }
+        }
+
+        eliminateVertex(v);
+
+        for(size_t n = 0; n < neighbours.size(); ++n) {
+          if(isIntermediate(neighbours[n])) {
+            queue.push(QueueEntry(getCost(neighbours[n]), neighbours[n]));
+          }
+        }
+      }
+    }
+
+    void eliminateVertex(const size_t v) {
+      Vertex& vertex = vertices[v];
+
+      for(size_t s = 0; s < vertex.succs.size(); ++s) {
+        const size_t succ = vertex.succs[s];
+        std::vector<Edge>& succPreds = vertices[succ].preds;
+
+        size_t pos = 0;
+        while(succPreds[pos].vertex != v) {
+          ++pos;
+        }
+        const Real jacobi = succPreds[pos].jacobi;
+        succPreds.erase(succPreds.begin() + pos);
+
+        for(size_t p = 0; p < vertex.preds.size(); ++p) {
+          Edge edge = vertex.preds[p];
+          edge.jacobi = edge.jacobi * jacobi;
+          if(addEdge(succPreds, edge) && noVertex() != edge.vertex) {
+            vertices[edge.vertex].succs.push_back(succ);
+          }
+        }
+      }
+
+      for(size_t p = 0; p < vertex.preds.size(); ++p) {
+        const size_t pred = vertex.preds[p].vertex;
+        if(noVertex() != pred) {
+          std::vector<size_t>& predSuccs = vertices[pred].succs;
+          predSuccs.erase(std::find(predSuccs.begin(), predSuccs.end(), v));
+        }
+      }
+
+      vertex.removed = true;
+      std::vector<Edge>().swap(vertex.preds);
+      std::vector<size_t>().swap(vertex.succs);
+      removedCount += 1;
+    }
+
+    void storeStatements(const Index& firstIndex) {
+      if(renumber) {
+        newIndices.assign((size_t)maxIndex + 1, 0);
+        for(size_t i = 0; i <= (size_t)firstIndex && i < newIndices.size(); ++i) {
+          newIndices[i] = (Index)i;
+        }
+      }
+
+      Index nextIndex = firstIndex;
+      for(size_t v = 0; v < vertices.size(); ++v) {
+        Vertex& vertex = vertices[v];
+        if(vertex.removed) {
+          continue;
+        }
+
+        if(renumber) {
+          nextIndex += 1;
+          vertex.newLhs = nextIndex;
+          newIndices[vertex.lhs] = nextIndex;
+        }
+
+        lhsIndices.push_back(vertex.newLhs);
+        if(vertex.input) {
+          statements.push_back(StatementIntInputTag);
+        } else {
+          statements.push_back((StatementInt)vertex.preds.size());
+          for(size_t p = 0; p < vertex.preds.size(); ++p) {
+            const Edge& edge = vertex.preds[p];
+            argumentIndices.push_back(noVertex() == edge.vertex ? edge.index : vertices[edge.vertex].newLhs);
+            jacobies.push_back(edge.jacobi);
+          }
+        }
+      }
+    }
+  };
+}
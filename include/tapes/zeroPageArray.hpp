@@ -0,0 +1,248 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
+#include "../configure.h"
+#include "../macros.h"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Resizes and deletes the arrays for the adjoint and primal vectors of the tapes.
+   *
+   * The new entries of a resized array are default constructed. If ZeroPageVectors is set, the arrays are
+   * anonymous memory mappings which are grown with mremap. The pages are not copied and the kernel provides
+   * zero pages for untouched entries. Since a default constructed trivial type is zero, the new entries of
+   * such types are not written and the pages are only touched when the entries are used.
+   *
+   * The unused bytes of the last page are kept zero, such that a later growth finds zeroed entries.
+   *
+   * @tparam Data  The type of the entries. Needs to be movable by a bitwise copy.
+   */
+  template<typename Data>
+  struct ZeroPageArray {
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+      /** @brief Indicates if the memory mappings are available on the system. */
+      static const bool MappingAvailable = true;
+#else
+      /** @brief Indicates if the memory mappings are available on the system. */
+      static const bool MappingAvailable = false;
+#endif
+
+      /** @brief Indicates if the arrays are memory mappings. */
+      static const bool UseMapping = ZeroPageVectors && MappingAvailable;
+
+      /** @brief Ranges with at least this number of bytes are zeroed by releasing their pages. */
+      static const size_t ReleaseThreshold = 1048576;
+
+      /**
+       * @brief Resize the array and default construct the new entries.
+       *
+       * @param[in] data  The array or NULL.
+       * @param[in] oldSize  The current number of entries.
+       * @param[in] newSize  The new number of entries.
+       *
+       * @return The resized array.
+       */
+      static Data* resize(Data* data, const size_t oldSize, const size_t newSize) {
+        if(!std::is_trivially_destructible<Data>::value) {
+          for(size_t i = newSize; i < oldSize; ++i) {
+            data[i].~Data();
+          }
+        }
+
+        if(UseMapping) {
+          data = static_cast<Data*>(remap(data, oldSize * sizeof(Data), newSize * sizeof(Data)));
+        } else {
+          data = static_cast<Data*>(realloc(static_cast<void*>(data), newSize * sizeof(Data)));
+
+          if(NULL == data && 0 != newSize) {
+            throw std::bad_alloc();
+          }
+        }
+
+        if(!UseMapping || !std::is_trivial<Data>::value) {
+          for(size_t i = oldSize; i < newSize; ++i) {
+            new (data + i) Data();
+          }
+        }
+
+        return data;
+      }
+
+      /**
+       * @brief Delete an array from resize.
+       *
+       * @param[in] data  The array or NULL.
+       * @param[in] size  The number of entries.
+       */
+      static void release(Data* data, const size_t size) {
+        if(NULL != data) {
+          if(!std::is_trivially_destructible<Data>::value) {
+            for(size_t i = 0; i < size; ++i) {
+              data[i].~Data();
+            }
+          }
+
+          if(UseMapping) {
+            remap(data, size * sizeof(Data), 0);
+          } else {
+            free(data);
+          }
+        }
+      }
+
+      /**
+       * @brief Release the memory of the full pages in the entries [first, end).
+       *
+       * The entries need to be zero. The kernel provides zero pages for them on the next access.
+       * Only the memory of mappings is released, otherwise nothing is done.
+       *
+       * @param[in]  data  The array.
+       * @param[in] first  The first entry of the range.
+       * @param[in]   end  The entry after the range.
+       */
+      static void releasePages(Data* data, const size_t first, const size_t end) {
+        if(UseMapping && first < end) {
+          releaseBytes((char*)(data + first), (char*)(data + end));
+        }
+      }
+
+      /**
+       * @brief Set the entries [first, end) to the default value.
+       *
+       * Large ranges of trivial types in mappings are zeroed by a release of their full pages, such that the
+       * memory of a cleared vector is returned to the system.
+       *
+       * @param[in,out] data  The array.
+       * @param[in]    first  The first entry of the range.
+       * @param[in]      end  The entry after the range.
+       */
+      static void zero(Data* data, const size_t first, const size_t end) {
+        if(UseMapping && std::is_trivial<Data>::value && first < end && (end - first) * sizeof(Data) >= ReleaseThreshold) {
+          char* begin = (char*)(data + first);
+          char* finish = (char*)(data + end);
+          std::pair<char*, char*> pages = releaseBytes(begin, finish);
+
+          memset(begin, 0, pages.first - begin);
+          memset(pages.second, 0, finish - pages.second);
+        } else {
+          for(size_t i = first; i < end; ++i) {
+            data[i] = Data();
+          }
+        }
+      }
+
+    private:
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+      static size_t pageSize() {
+        static const size_t size = (size_t)sysconf(_SC_PAGESIZE);
+
+        return size;
+      }
+
+      static size_t mappingSize(const size_t bytes) {
+        return (bytes + pageSize() - 1) / pageSize() * pageSize();
+      }
+
+      static std::pair<char*, char*> releaseBytes(char* begin, char* end) {
+        char* pagesBegin = (char*)(((uintptr_t)begin + pageSize() - 1) / pageSize() * pageSize());
+        char* pagesEnd = (char*)((uintptr_t)end / pageSize() * pageSize());
+
+        if(pagesBegin < pagesEnd) {
+          madvise(pagesBegin, pagesEnd - pagesBegin, MADV_DONTNEED);
+        } else {
+          pagesBegin = pagesEnd = begin;
+        }
+
+        return std::make_pair(pagesBegin, pagesEnd);
+      }
+
+      static void* remap(void* block, const size_t oldBytes, const size_t newBytes) {
+        size_t oldMapping = NULL == block ? 0 : mappingSize(oldBytes);
+        size_t newMapping = mappingSize(newBytes);
+
+        if(newBytes < oldBytes && 0 != newMapping) {
+          // the remaining part of the last page needs to be zero for the next growth
+          memset((char*)block + newBytes, 0, std::min(oldBytes, newMapping) - newBytes);
+        }
+
+        void* mapping = block;
+        if(oldMapping == newMapping) {
+          // nothing to do
+        } else if(0 == newMapping) {
+          munmap(block, oldMapping);
+          mapping = NULL;
+        } else if(0 == oldMapping) {
+          mapping = mmap(NULL, newMapping, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        } else {
+          mapping = mremap(block, oldMapping, newMapping, MREMAP_MAYMOVE);
+        }
+
+        if(MAP_FAILED == mapping) {
+          throw std::bad_alloc();
+        }
+
+        return mapping;
+      }
+#else
+      static void* remap(void* block, const size_t oldBytes, const size_t newBytes) {
+        CODI_UNUSED(block);
+        CODI_UNUSED(oldBytes);
+        CODI_UNUSED(newBytes);
+
+        return NULL; // not used without mappings
+      }
+
+      static std::pair<char*, char*> releaseBytes(char* begin, char* end) {
+        CODI_UNUSED(end);
+
+        return std::make_pair(begin, begin); // not used without mappings
+      }
+#endif
+  };
+}
@@ -0,0 +1,495 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#pragma once
+
+#include <atomic>
+
+#include "../adjointInterface.hpp"
+#include "../adjointInterfaceImpl.hpp"
+#include "../configure.h"
+#include "../typeFunctions.hpp"
+#include "direction.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief An adjoint value that can be updated by several threads at the same time.
+   *
+   * The type can be used as the adjoint data for the evaluate methods of the tapes, e.g.
+   * \code{.cpp}
+   *  std::vector<codi::AtomicGradient<double> > adjoints(tape.getAdjointSize() + 1);
+   *  tape.evaluate(start, end, adjoints.data());
+   * \endcode
+   * If several threads evaluate independent tape ranges with the same adjoint vector, the updates of the shared
+   * adjoint values are performed with atomic additions. All operations use the relaxed memory order, the
+   * synchronization of the threads needs to be done by the user. Reads of the value are plain loads.
+   *
+   * @tparam Real  The floating point type of the adjoint value.
+   */
+  template<typename Real>
+  struct AtomicGradient {
+    private:
+      std::atomic<Real> value; /**< The atomic storage of the value. */
+
+    public:
+
+      /**
+       * @brief Creates a zero value.
+       */
+      CODI_INLINE AtomicGradient() :
+        value(Real()) {}
+
+      /**
+       * @brief Creates the value from a passive value.
+       *
+       * @param[in] v  The initial value.
+       */
+      CODI_INLINE AtomicGradient(const Real& v) :
+        value(v) {}
+
+      /**
+       * @brief Creates a copy of the other value.
+       *
+       * @param[in] other  The value that is loaded.
+       */
+      CODI_INLINE AtomicGradient(const AtomicGradient& other) :
+        value(other.value.load(std::memory_order_relaxed)) {}
+
+      /**
+       * @brief Store the value of the other atomic gradient.
+       *
+       * @param[in] other  The value that is loaded.
+       *
+       * @return Reference to this value.
+       */
+      CODI_INLINE AtomicGradient& operator = (const AtomicGradient& other) {
+        value.store(other.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        return *this;
+      }
+
+      /**
+       * @brief Store a passive value.
+       *
+       * @param[in] v  The new value.
+       *
+       * @return Reference to this value.
+       */
+      CODI_INLINE AtomicGradient& operator = (const Real& v) {
+        value.store(v, std::memory_order_relaxed);
+
+        return *this;
+      }
+
+      /**
+       * @brief Atomic addition of the value.
+       *
+       * @param[in] v  The value that is added.
+       *
+       * @return Reference to this value.
+       */
+      CODI_INLINE AtomicGradient& operator += (const Real& v) {
+        Real cur = value.load(std::memory_order_relaxed);
+        while(!value.compare_exchange_weak(cur, cur + v, std::memory_order_relaxed)) {
+          // cur is updated by compare_exchange_weak
+        }
+
+        return *this;
+      }
+
+      /**
+       * @brief Atomic subtraction of the value.
+       *
+       * @param[in] v  The value that is subtracted.
+       *
+       * @return Reference to this value.
+       */
+      CODI_INLINE AtomicGradient& operator -= (const Real& v) {
+        Real cur = value.load(std::memory_order_relaxed);
+        while(!value.compare_exchange_weak(cur, cur - v, std::memory_order_relaxed)) {
+          // cur is updated by compare_exchange_weak
+        }
+
+        return *this;
+      }
+
+      /**
+       * @brief Load the current value.
+       *
+       * @return The current value.
+       */
+      CODI_INLINE operator Real() const {
+        return value.load(std::memory_order_relaxed);
+      }
+
+      /**
+       * @brief Checks if the current value is a total zero.
+       *
+       * @return true if the value is a total zero.
+       */
+      CODI_INLINE bool isTotalZero() const {
+        return codi::isTotalZero(value.load(std::memory_order_relaxed));
+      }
+  };
+
+  /**
+   * @brief Specialization of the atomic gradient for the vector mode.
+   *
+   * Each component of the direction is updated atomically. The direction as a whole is not updated atomically.
+   *
+   * @tparam Real  The scalar value type that is used by the direction.
+   * @tparam  dim  The dimension of the direction.
+   */
+  template<typename Real, size_t dim>
+  struct AtomicGradient<Direction<Real, dim> > {
+    private:
+      AtomicGradient<Real> vector[dim]; /**< The atomic components. */
+
+    public:
+
+      /**
+       * @brief Creates a zero direction.
+       */
+      CODI_INLINE AtomicGradient() :
+        vector() {}
+
+      /**
+       * @brief Creates the value from a direction.
+       *
+       * @param[in] v  The initial direction.
+       */
+      CODI_INLINE AtomicGradient(const Direction<Real, dim>& v) :
+        vector()
+      {
+        for(size_t i = 0; i < dim; ++i) {
+          vector[i] = v[i];
+        }
+      }
+
+      /**
+       * @brief Creates a copy of the other value.
+       *
+       * @param[in] other  The value that is loaded.
+       */
+      CODI_INLINE AtomicGradient(const AtomicGradient& other) :
+        vector()
+      {
+        for(size_t i = 0; i < dim; ++i) {
+          vector[i] = other.vector[i];
+        }
+      }
+
+      /**
+       * @brief Store the components of the other atomic gradient.
+       *
+       * @param[in] other  The value that is loaded.
+       *
+       * @return Reference to this value.
+       */
+      CODI_INLINE AtomicGradient& operator = (const AtomicGradient& other) {
+        for(size_t i = 0; i < dim; ++i) {
+          vector[i] = other.vector[i];
+        }
+
+        return *this;
+      }
+
+      /**
+       * @brief Store the components of a direction.
+       *
+       * @param[in] v  The new direction.
+       *
+       * @return Reference to this value.
+       */
+      CODI_INLINE AtomicGradient& operator = (const Direction<Real, dim>& v) {
+        for(size_t i = 0; i < dim; ++i) {
+          vector[i] = v[i];
+        }
+
+        return *this;
+      }
+
+      /**
+       * @brief Get the i-th component of the direction.
+       *
+       * No bounds checks are performed.
+       *
+       * @param[in] i  The index for the vector.
+       *
+       * @return The atomic component.
+       */
+      CODI_INLINE AtomicGradient<Real>& operator[] (const size_t& i) {
+        return vector[i];
+      }
+
+      /**
+       * @brief Get the i-th component of the direction.
+       *
+       * No bounds checks are performed.
+       *
+       * @param[in] i  The index for the vector.
+       *
+       * @return The atomic component.
+       */
+      CODI_INLINE const AtomicGradient<Real>& operator[] (const size_t& i) const {
+        return vector[i];
+      }
+
+      /**
+       * @brief Atomic addition of each component.
+       *
+       * @param[in] v  The direction that is added.
+       *
+       * @return Reference to this value.
+       */
+      CODI_INLINE AtomicGradient& operator += (const Direction<Real, dim>& v) {
+        for(size_t i = 0; i < dim; ++i) {
+          vector[i] += v[i];
+        }
+
+        return *this;
+      }
+
+      /**
+       * @brief Atomic subtraction of each component.
+       *
+       * @param[in] v  The direction that is subtracted.
+       *
+       * @return Reference to this value.
+       */
+      CODI_INLINE AtomicGradient& operator -= (const Direction<Real, dim>& v) {
+        for(size_t i = 0; i < dim; ++i) {
+          vector[i] -= v[i];
+        }
+
+        return *this;
+      }
+
+      /**
+       * @brief Load the current components.
+       *
+       * @return The current direction.
+       */
+      CODI_INLINE operator Direction<Real, dim>() const {
+        Direction<Real, dim> r;
+        for(size_t i = 0; i < dim; ++i) {
+          r[i] = vector[i];
+        }
+
+        return r;
+      }
+
+      /**
+       * @brief Checks if all components are a total zero.
+       *
+       * @return true if all components are a total zero.
+       */
+      CODI_INLINE bool isTotalZero() const {
+        for(size_t i = 0; i < dim; ++i) {
+          if(!vector[i].isTotalZero()) {
+            return false;
+          }
+        }
+
+        return true;
+      }
+  };
+
+  /**
+   * @brief Scalar multiplication of an atomic direction.
+   *
+   * The components are loaded before the multiplication.
+   *
+   * @param[in] s  The scalar value for the multiplication.
+   * @param[in] v  The atomic direction that is multiplied.
+   *
+   * @return The direction with the result.
+   *
+   * @tparam Real  The scalar value type that is used by the direction.
+   * @tparam  dim  The dimension of the direction.
+   */
+  template<typename Real, size_t dim>
+  CODI_INLINE Direction<Real, dim> operator * (const Real& s, const AtomicGradient<Direction<Real, dim> >& v) {
+    return s * (Direction<Real, dim>)v;
+  }
+
+  /**
+   * @brief Scalar multiplication of an atomic direction.
+   *
+   * The components are loaded before the multiplication.
+   *
+   * @param[in] v  The atomic direction that is multiplied.
+   * @param[in] s  The scalar value for the multiplication.
+   *
+   * @return The direction with the result.
+   *
+   * @tparam Real  The scalar value type that is used by the direction.
+   * @tparam  dim  The dimension of the direction.
+   */
+  template<typename Real, size_t dim>
+  CODI_INLINE Direction<Real, dim> operator * (const AtomicGradient<Direction<Real, dim> >& v, const Real& s) {
+    return (Direction<Real, dim>)v * s;
+  }
+
+  /**
+   * @brief Specialization of the adjoint interface for the atomic directions.
+   *
+   * @tparam    Real  The primal value of the CoDiPack type.
+   * @tparam RealDir  The type for the entries of the vectors.
+   * @tparam  vecDim  The dimension of the vector
+   */
+  template<typename Real, typename RealDir, size_t vecDim>
+  struct AdjointInterfaceImplBase <Real, AtomicGradient<Direction<RealDir, vecDim> > > : public AdjointInterface<Real> {
+      AtomicGradient<Direction<RealDir, vecDim> >* adjointVector; /**< The vector for the adjoint data.*/
+
+      Direction<RealDir, vecDim> lhs; /**< The stored value for the inplace updates. */
+
+      /**
+       * @brief Create a new instance.
+       *
+       * The vector is used for all operations.
+       * @param[in] adjointVector  The adjoint vector on which all the operations are evaluated.
+       */
+      explicit AdjointInterfaceImplBase(AtomicGradient<Direction<RealDir, vecDim> >* adjointVector) :
+        adjointVector(adjointVector) {}
+
+      /**
+       * @brief Get the vector size of an adjoint value.
+       * @return The vector size of an adjoint value.
+       */
+      size_t getVectorSize() const {
+        return vecDim;
+      }
+
+      /**
+       * @brief Set the adjoint value at the position and dimension to zero.
+       *
+       * @param[in] index  The position for the adjoint.
+       * @param[in]   dim  The dimension in the vector.
+       */
+      void resetAdjoint(const size_t index, const size_t dim) {
+        adjointVector[index][dim] = RealDir();
+      }
+
+      /**
+       * @brief Set the adjoint vector at the position to zero.
+       * @param[in] index  The position for the adjoint.
+       */
+      void resetAdjointVec(const size_t index) {
+        adjointVector[index] = Direction<RealDir, vecDim>();
+      }
+
+      /**
+       * @brief Get the adjoint value at the specified position and dimension.
+       *
+       * @param[in] index  The position for the adjoint
+       * @param[in]   dim  The dimension in the vector.
+       * @return The adjoint value at the position with the dimension.
+       */
+      Real getAdjoint(const size_t index, const size_t dim) {
+        return (Real)(RealDir)adjointVector[index][dim];
+      }
+
+      /**
+       * @brief Get the adjoint vector at the specified position.
+       *
+       * @param[in]  index  The position for the adjoint
+       * @param[out]   vec  The vector for the adjoint values. It has the size getVectorSize().
+       */
+      void getAdjointVec(const size_t index, Real* vec) {
+        for(size_t i = 0; i < vecDim; ++i) {
+          vec[i] = (Real)(RealDir)adjointVector[index][i];
+        }
+      }
+
+      /**
+       * @brief Atomic update of the adjoint value at the specified position and dimension.
+       *
+       * @param[in]   index  The position for the adjoint
+       * @param[in]     dim  The dimension in the vector.
+       * @param[in] adjoint  The value which is added to the adjoint value.
+       */
+      virtual void updateAdjoint(const size_t index, const size_t dim, const Real adjoint) {
+        adjointVector[index][dim] += adjoint;
+      }
+
+      /**
+       * @brief Atomic update of the adjoint vector at the specified position.
+       *
+       * @param[in] index  The position for the adjoint
+       * @param[in]   vec  The values which are added to the adjoint vector. It has the size getVectorSize().
+       */
+      virtual void updateAdjointVec(const size_t index, const Real* vec) {
+        for(size_t i = 0; i < vecDim; ++i) {
+          adjointVector[index][i] += vec[i];
+        }
+      }
+
+      /**
+       * @brief Set the adjoint value of the lhs for the inplace updates.
+       *
+       * @param[in] index  The index of the lhs value.
+       */
+      void setLhsAdjoint(const size_t index) {
+        lhs = adjointVector[index];
+      }
+
+      /**
+       * @brief Atomic update of the adjoint value with the lhs adjoint multiplied with the jacobi.
+       *
+       * @param[in]  index  The index of the adjoint value that is updated.
+       * @param[in] jacobi  The jacobi value that is multiplied with the lhs adjoint.
+       */
+      void updateJacobiAdjoint(const size_t index, Real jacobi) {
+        adjointVector[index] += jacobi * lhs;
+      }
+
+      /**
+       * @brief Store the lhs tangent value and set the lhs tangent to zero.
+       *
+       * @param[in] index  The index of the lhs value.
+       */
+      void setLhsTangent(const size_t index) {
+        adjointVector[index] = lhs;
+        lhs = Direction<RealDir, vecDim>();
+      }
+
+      /**
+       * @brief Updates the lhs tangent with the jacobian multiplied with target tangent value.
+       *
+       * @param[in]  index  The index of the tangent value that is used for the update.
+       * @param[in] jacobi  The jacobi value that is multiplied with the tangent value defined by index.
+       */
+      void updateJacobiTangent(const size_t index, Real jacobi) {
+        lhs += jacobi * adjointVector[index];
+      }
+  };
+}
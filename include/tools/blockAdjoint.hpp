@@ -0,0 +1,413 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#pragma once
+
+#include <vector>
+
+#include "../adjointInterface.hpp"
+#include "../adjointInterfaceImpl.hpp"
+#include "../configure.h"
+#include "../macros.h"
+#include "../typeFunctions.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief An adjoint vector with a number of directions that is set at run time.
+   *
+   * The adjoints are stored as one contiguous matrix with one row for each index and one column for each direction.
+   * The tapes evaluate all directions in one sweep if a pointer to the block is given as the adjoint data:
+   * \code{.cpp}
+   *  codi::BlockAdjoint<double> block(k);
+   *  block.resize(tape.getAdjointSize() + 1);
+   *  for(size_t j = 0; j < k; ++j) {
+   *    block.at(y[j].getGradientData(), j) = 1.0;
+   *  }
+   *  tape.evaluate(tape.getPosition(), tape.getZeroPosition(), &block);
+   *  double d = block.at(x.getGradientData(), 0);
+   * \endcode
+   *
+   * The Jacobi tapes provide a specialized evaluation for the block. The primal value tapes use the
+   * AdjointInterface for the evaluation and require the preprocessor option
+   * CODI_EnableVariableAdjointInterfaceInPrimalTapes.
+   *
+   * @tparam Real  The floating point type of the adjoint values.
+   */
+  template<typename Real>
+  struct BlockAdjoint {
+    private:
+      size_t dim; /**< The number of directions. */
+      size_t size; /**< The number of rows. */
+
+      std::vector<Real> data; /**< The matrix with size * dim entries. */
+
+      std::vector<Real> lhs; /**< The buffer for the row of the lhs during the evaluation. */
+
+    public:
+
+      /**
+       * @brief Create an empty block with the given number of directions.
+       *
+       * @param[in] dim  The number of directions.
+       */
+      explicit BlockAdjoint(const size_t dim) :
+        dim(dim),
+        size(0),
+        data(),
+        lhs(dim) {}
+
+      /**
+       * @brief Get the number of directions.
+       *
+       * @return The number of directions.
+       */
+      CODI_INLINE size_t getDimension() const {
+        return dim;
+      }
+
+      /**
+       * @brief Get the number of rows.
+       *
+       * @return The number of rows.
+       */
+      CODI_INLINE size_t getSize() const {
+        return size;
+      }
+
+      /**
+       * @brief Set the number of rows. New rows are zero.
+       *
+       * @param[in] newSize  The new number of rows.
+       */
+      void resize(const size_t newSize) {
+        size = newSize;
+        data.resize(size * dim);
+      }
+
+      /**
+       * @brief Set all entries to zero.
+       */
+      void clear() {
+        for(size_t i = 0; i < data.size(); ++i) {
+          data[i] = Real();
+        }
+      }
+
+      /**
+       * @brief Get the row for the index.
+       *
+       * @param[in] index  The index of the row.
+       *
+       * @return The pointer to the first direction of the row.
+       */
+      CODI_INLINE Real* row(const size_t index) {
+        codiAssert(index < size);
+
+        return &data[index * dim];
+      }
+
+      /**
+       * @brief Get the row for the index.
+       *
+       * @param[in] index  The index of the row.
+       *
+       * @return The pointer to the first direction of the row.
+       */
+      CODI_INLINE const Real* row(const size_t index) const {
+        codiAssert(index < size);
+
+        return &data[index * dim];
+      }
+
+      /**
+       * @brief Access one entry of the block.
+       *
+       * @param[in] index  The index of the row.
+       * @param[in]     d  The direction.
+       *
+       * @return The reference to the entry.
+       */
+      CODI_INLINE Real& at(const size_t index, const size_t d) {
+        return row(index)[d];
+      }
+
+      /**
+       * @brief Access one entry of the block.
+       *
+       * @param[in] index  The index of the row.
+       * @param[in]     d  The direction.
+       *
+       * @return The entry.
+       */
+      CODI_INLINE const Real& at(const size_t index, const size_t d) const {
+        return row(index)[d];
+      }
+
+      /**
+       * @brief Copy the row of the index into the lhs buffer and optionally zero the row.
+       *
+       * @param[in] index  The index of the lhs.
+       * @param[in] reset  If the row is set to zero.
+       *
+       * @return The pointer to the lhs buffer.
+       */
+      CODI_INLINE const Real* loadLhs(const size_t index, const bool reset) {
+        Real* r = row(index);
+        for(size_t d = 0; d < dim; ++d) {
+          lhs[d] = r[d];
+        }
+        if(reset) {
+          for(size_t d = 0; d < dim; ++d) {
+            r[d] = Real();
+          }
+        }
+
+        return lhs.data();
+      }
+
+      /**
+       * @brief Get the lhs buffer.
+       *
+       * @return The pointer to the lhs buffer.
+       */
+      CODI_INLINE Real* getLhs() {
+        return lhs.data();
+      }
+
+      /**
+       * @brief Checks if all entries of the row are a total zero.
+       *
+       * @param[in] r  The row that is checked.
+       *
+       * @return true if all entries are zero.
+       */
+      CODI_INLINE bool isTotalZero(const Real* r) const {
+        for(size_t d = 0; d < dim; ++d) {
+          if(!codi::isTotalZero(r[d])) {
+            return false;
+          }
+        }
+
+        return true;
+      }
+
+      /**
+       * @brief Performs row(index) += v.
+       *
+       * @param[in] index  The index of the updated row.
+       * @param[in]     v  The row that is added.
+       */
+      CODI_INLINE void addRow(const size_t index, const Real* v) {
+        Real* r = row(index);
+        for(size_t d = 0; d < dim; ++d) {
+          r[d] += v[d];
+        }
+      }
+
+      /**
+       * @brief Performs row(index) -= v.
+       *
+       * @param[in] index  The index of the updated row.
+       * @param[in]     v  The row that is subtracted.
+       */
+      CODI_INLINE void subRow(const size_t index, const Real* v) {
+        Real* r = row(index);
+        for(size_t d = 0; d < dim; ++d) {
+          r[d] -= v[d];
+        }
+      }
+
+      /**
+       * @brief Performs row(index) += v * jacobi.
+       *
+       * @param[in]  index  The index of the updated row.
+       * @param[in]      v  The row that is scaled.
+       * @param[in] jacobi  The scaling factor.
+       */
+      CODI_INLINE void addScaledRow(const size_t index, const Real* v, const Real& jacobi) {
+        Real* r = row(index);
+        for(size_t d = 0; d < dim; ++d) {
+          r[d] += v[d] * jacobi;
+        }
+      }
+  };
+
+  /**
+   * @brief Specialization for the codi::BlockAdjoint structure.
+   *
+   * All operations are performed on the complete row of an index. The lhs value is stored in the buffer of the block.
+   *
+   * @tparam      Real  The primal value of the CoDiPack type.
+   * @tparam RealBlock  The type for the entries of the block. This type needs to support addition and multiplication
+   *                    operations.
+   */
+  template<typename Real, typename RealBlock>
+  struct AdjointInterfaceImplBase <Real, BlockAdjoint<RealBlock> > : public AdjointInterface<Real> {
+      BlockAdjoint<RealBlock>* block; /**< The block for the adjoint data.*/
+
+      /**
+       * @brief Create a new instance.
+       *
+       * The block is used for all operations.
+       * @param[in] block  The block on which all the operations are evaluated.
+       */
+      explicit AdjointInterfaceImplBase(BlockAdjoint<RealBlock>* block) :
+        block(block) {}
+
+      /**
+       * @brief Get the vector size of an adjoint value.
+       * @return The number of directions of the block.
+       */
+      size_t getVectorSize() const {
+        return block->getDimension();
+      }
+
+      /**
+       * @brief Set the adjoint value at the position and dimension to zero.
+       *
+       * @param[in] index  The position for the adjoint.
+       * @param[in]   dim  The dimension in the vector.
+       */
+      void resetAdjoint(const size_t index, const size_t dim) {
+        block->at(index, dim) = RealBlock();
+      }
+
+      /**
+       * @brief Set the adjoint vector at the position to zero.
+       * @param[in] index  The position for the adjoint.
+       */
+      void resetAdjointVec(const size_t index) {
+        RealBlock* r = block->row(index);
+        for(size_t i = 0; i < block->getDimension(); ++i) {
+          r[i] = RealBlock();
+        }
+      }
+
+      /**
+       * @brief Get the adjoint value at the specified position and dimension.
+       *
+       * @param[in] index  The position for the adjoint
+       * @param[in]   dim  The dimension in the vector.
+       * @return The adjoint value at the position with the dimension.
+       */
+      Real getAdjoint(const size_t index, const size_t dim) {
+        return (Real) block->at(index, dim);
+      }
+
+      /**
+       * @brief Get the adjoint vector at the specified position.
+       *
+       * @param[in] index  The position for the adjoint
+       * @param[out]  vec  The vector for the storage of the data.
+       */
+      void getAdjointVec(const size_t index, Real* vec) {
+        const RealBlock* r = block->row(index);
+        for(size_t i = 0; i < block->getDimension(); ++i) {
+          vec[i] = (Real)r[i];
+        }
+      }
+
+      /**
+       * @brief Update the adjoint value at the specified position and dimension.
+       *
+       * @param[in]   index  The position for the adjoint
+       * @param[in]     dim  The dimension in the vector.
+       * @param[in] adjoint  The update for the adjoint value.
+       */
+      virtual void updateAdjoint(const size_t index, const size_t dim, const Real adjoint) {
+        block->at(index, dim) += adjoint;
+      }
+
+      /**
+       * @brief Update the adjoint vector at the specified position.
+       *
+       * @param[in] index  The position for the adjoint
+       * @param[in]   vec  The update for the adjoint value.
+       */
+      virtual void updateAdjointVec(const size_t index, const Real* vec) {
+        RealBlock* r = block->row(index);
+        for(size_t i = 0; i < block->getDimension(); ++i) {
+          r[i] += vec[i];
+        }
+      }
+
+      /**
+       * @brief The adjoint row of the index is copied into the lhs buffer of the block.
+       *
+       * See AdjointInterface::setLhsAdjoint for details.
+       *
+       * @param[in] index  The index of the adjoint value that is stored.
+       */
+      void setLhsAdjoint(const size_t index) {
+        block->loadLhs(index, false);
+      }
+
+      /**
+       * @brief Updates the target adjoint with the prior specified lhs multiplied with the jacobi.
+       *
+       * @param[in]  index  The index of the adjoint value that receives the update.
+       * @param[in] jacobi  The jacobi value that is multiplied with the lhs adjoint.
+       */
+      void updateJacobiAdjoint(const size_t index, Real jacobi) {
+        block->addScaledRow(index, block->getLhs(), jacobi);
+      }
+
+      /**
+       * @brief Sets the tangent row of the index to the accumulated lhs buffer and resets the buffer.
+       *
+       * See AdjointInterface::setLhsTangent for details.
+       *
+       * @param[in] index  The index of the tangent value that is set to the current accumulated value.
+       */
+      void setLhsTangent(const size_t index) {
+        RealBlock* r = block->row(index);
+        RealBlock* lhs = block->getLhs();
+        for(size_t i = 0; i < block->getDimension(); ++i) {
+          r[i] = lhs[i];
+          lhs[i] = RealBlock();
+        }
+      }
+
+      /**
+       * @brief Updates the lhs buffer with the jacobian multiplied with target tangent value.
+       *
+       * @param[in]  index  The index of the tangent value that is used for the update.
+       * @param[in] jacobi  The jacobi value that is multiplied with the tangent value defined by index.
+       */
+      void updateJacobiTangent(const size_t index, Real jacobi) {
+        const RealBlock* r = block->row(index);
+        RealBlock* lhs = block->getLhs();
+        for(size_t i = 0; i < block->getDimension(); ++i) {
+          lhs[i] += jacobi * r[i];
+        }
+      }
+  };
+}
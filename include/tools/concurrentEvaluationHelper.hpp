@@ -0,0 +1,144 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "../configure.h"
+#include "../macros.h"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Evaluates one recorded tape for several seeds in parallel.
+   *
+   * Each thread owns an adjoint vector and evaluates the tape range with it. The tape is only read during the
+   * evaluations, it must not be changed while the helper is used. The threads are created with OpenMP, without
+   * OpenMP the seeds are evaluated one after the other.
+   *
+   * A usage example is:
+   * \code{.cpp}
+   *  codi::ConcurrentEvaluationHelper<codi::RealReverse> helper;
+   *
+   *  auto seed = [&] (size_t i, double* adjoints) {
+   *    adjoints[y[i].getGradientData()] = 1.0;
+   *  };
+   *  auto result = [&] (size_t i, const double* adjoints) {
+   *    for(size_t j = 0; j < n; ++j) {
+   *      jacobian[i][j] = adjoints[x[j].getGradientData()];
+   *    }
+   *  };
+   *
+   *  helper.evaluate(tape.getPosition(), tape.getZeroPosition(), m, seed, result);
+   * \endcode
+   *
+   * The tape needs to support the concurrent evaluation, see Tape::AllowConcurrentEvaluation. External functions
+   * in the range need to be declared as reentrant, see ExternalFunction::setReentrant. If one of the conditions
+   * is not met, all seeds are evaluated by the calling thread.
+   *
+   * @tparam      CoDiType  This is the CoDiPack type that is used in the application, e.g. RealReverse.
+   * @tparam GradientValue  The type of the entries in the adjoint vectors.
+   */
+  template<typename CoDiType, typename GradientValue = typename CoDiType::GradientValue>
+  struct ConcurrentEvaluationHelper {
+
+      typedef typename CoDiType::TapeType Tape; /**< The type of the tape implementation. */
+      typedef typename Tape::Position Position; /**< The position for the tape. */
+
+      Tape& tape; /**< The tape that is evaluated. */
+
+      /**
+       * @brief Create a helper for the global tape.
+       */
+      ConcurrentEvaluationHelper() :
+        tape(CoDiType::getGlobalTape()) {}
+
+      /**
+       * @brief Create a helper for the given tape.
+       *
+       * @param[in] tape  The tape that is evaluated.
+       */
+      explicit ConcurrentEvaluationHelper(Tape& tape) :
+        tape(tape) {}
+
+      /**
+       * @brief Perform a reverse evaluation of the range for each seed.
+       *
+       * For each seed the calls are:
+       * \code{.cpp}
+       *  seed(i, adjoints);
+       *  tape.evaluate(start, end, adjoints);
+       *  result(i, adjoints);
+       * \endcode
+       * The adjoint vector is zero before each seed. The functions seed and result are called concurrently
+       * for different i.
+       *
+       * It has to hold start >= end.
+       *
+       * @param[in]  start  The starting point for the evaluation.
+       * @param[in]    end  The ending point for the evaluation.
+       * @param[in]  count  The number of seeds.
+       * @param[in]   seed  Sets the seed into the adjoint vector.
+       * @param[in] result  Reads the results from the adjoint vector.
+       *
+       * @tparam   SeedFunc  A function object with the arguments (size_t, GradientValue*).
+       * @tparam ResultFunc  A function object with the arguments (size_t, const GradientValue*).
+       */
+      template<typename SeedFunc, typename ResultFunc>
+      void evaluate(const Position& start, const Position& end, const size_t count, const SeedFunc& seed, const ResultFunc& result) {
+        const size_t adjointSize = (size_t)tape.getAdjointSize() + 1;
+        const long seedCount = (long)count;
+        const bool concurrent = Tape::AllowConcurrentEvaluation && tape.isExtFuncReentrant(start, end);
+        CODI_UNUSED(concurrent);
+
+#ifdef _OPENMP
+        #pragma omp parallel if(concurrent)
+#endif
+        {
+          std::vector<GradientValue> adjoints(adjointSize);
+
+#ifdef _OPENMP
+          #pragma omp for schedule(dynamic)
+#endif
+          for(long i = 0; i < seedCount; ++i) {
+            seed((size_t)i, adjoints.data());
+            tape.evaluate(start, end, adjoints.data());
+            result((size_t)i, const_cast<const GradientValue*>(adjoints.data()));
+
+            for(size_t j = 0; j < adjointSize; ++j) {
+              adjoints[j] = GradientValue();
+            }
+          }
+        }
+      }
+  };
+}
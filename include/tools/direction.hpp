@@ -29,16 +29,155 @@
 
 #pragma once
 
+#include <cmath>
 #include <initializer_list>
 
 #include "../configure.h"
 #include "../typeFunctions.hpp"
 
+#if CODI_EnableDirectionIntrinsics && (defined(__SSE2__) || defined(__AVX__) || defined(__AVX512F__))
+  #include <immintrin.h>
+#endif
+
 /**
  * @brief Global namespace for CoDiPack - Code Differentiation Package
  */
 namespace codi {
 
+  /**
+   * @brief The element wise operations for the data of a Direction.
+   *
+   * The general implementation uses plain loops.
+   *
+   * @tparam Real  The scalar value type that is used by the array.
+   * @tparam  dim  The dimension of the array.
+   */
+  template<typename Real, size_t dim>
+  struct DirectionKernels {
+
+      /**
+       * @brief Performs t += v.
+       *
+       * @param[in,out] t  The data that is updated.
+       * @param[in]     v  The data that is added.
+       */
+      static CODI_INLINE void add(Real* t, const Real* v) {
+        for(size_t i = 0; i < dim; ++i) {
+          t[i] += v[i];
+        }
+      }
+
+      /**
+       * @brief Performs t += s * v.
+       *
+       * @param[in,out] t  The data that is updated.
+       * @param[in]     v  The data that is scaled and added.
+       * @param[in]     s  The scaling factor.
+       */
+      static CODI_INLINE void addScaled(Real* t, const Real* v, const Real& s) {
+        for(size_t i = 0; i < dim; ++i) {
+          t[i] += s * v[i];
+        }
+      }
+  };
+
+#if CODI_EnableDirectionIntrinsics && (defined(__SSE2__) || defined(__AVX__) || defined(__AVX512F__))
+  /**
+   * @brief SIMD implementation of the element wise operations for double values.
+   *
+   * The widest available instruction set is used first, the remaining elements are handled by the smaller ones.
+   * The data is loaded unaligned. The scaled addition uses a separate multiplication and addition for all elements.
+   * If CODI_EnableDirectionFMA is set, it is fused for all elements, see configure.h.
+   *
+   * @tparam dim  The dimension of the array.
+   */
+  template<size_t dim>
+  struct DirectionKernels<double, dim> {
+
+      /**
+       * @brief Performs t += v.
+       *
+       * @param[in,out] t  The data that is updated.
+       * @param[in]     v  The data that is added.
+       */
+      static CODI_INLINE void add(double* t, const double* v) {
+        size_t i = 0;
+  #if defined(__AVX512F__)
+        for(; i + 8 <= dim; i += 8) {
+          _mm512_storeu_pd(t + i, _mm512_add_pd(_mm512_loadu_pd(t + i), _mm512_loadu_pd(v + i)));
+        }
+  #endif
+  #if defined(__AVX__)
+        for(; i + 4 <= dim; i += 4) {
+          _mm256_storeu_pd(t + i, _mm256_add_pd(_mm256_loadu_pd(t + i), _mm256_loadu_pd(v + i)));
+        }
+  #endif
+  #if defined(__SSE2__)
+        for(; i + 2 <= dim; i += 2) {
+          _mm_storeu_pd(t + i, _mm_add_pd(_mm_loadu_pd(t + i), _mm_loadu_pd(v + i)));
+        }
+  #endif
+        for(; i < dim; ++i) {
+          t[i] += v[i];
+        }
+      }
+
+      /**
+       * @brief Performs t += s * v.
+       *
+       * @param[in,out] t  The data that is updated.
+       * @param[in]     v  The data that is scaled and added.
+       * @param[in]     s  The scaling factor.
+       */
+      static CODI_INLINE void addScaled(double* t, const double* v, const double& s) {
+        size_t i = 0;
+  #if CODI_EnableDirectionFMA
+    #if defined(__AVX512F__)
+        const __m512d s8 = _mm512_set1_pd(s);
+        for(; i + 8 <= dim; i += 8) {
+          _mm512_storeu_pd(t + i, _mm512_fmadd_pd(s8, _mm512_loadu_pd(v + i), _mm512_loadu_pd(t + i)));
+        }
+    #endif
+    #if defined(__FMA__)
+        const __m256d s4 = _mm256_set1_pd(s);
+        for(; i + 4 <= dim; i += 4) {
+          _mm256_storeu_pd(t + i, _mm256_fmadd_pd(s4, _mm256_loadu_pd(v + i), _mm256_loadu_pd(t + i)));
+        }
+        const __m128d s2 = _mm_set1_pd(s);
+        for(; i + 2 <= dim; i += 2) {
+          _mm_storeu_pd(t + i, _mm_fmadd_pd(s2, _mm_loadu_pd(v + i), _mm_loadu_pd(t + i)));
+        }
+    #endif
+        for(; i < dim; ++i) {
+          t[i] = std::fma(s, v[i], t[i]);
+        }
+  #else
+    #if defined(__AVX512F__)
+        const __m512d s8 = _mm512_set1_pd(s);
+        for(; i + 8 <= dim; i += 8) {
+          _mm512_storeu_pd(t + i, _mm512_add_pd(_mm512_loadu_pd(t + i), _mm512_mul_pd(s8, _mm512_loadu_pd(v + i))));
+        }
+    #endif
+    #if defined(__AVX__)
+        const __m256d s4 = _mm256_set1_pd(s);
+        for(; i + 4 <= dim; i += 4) {
+          _mm256_storeu_pd(t + i, _mm256_add_pd(_mm256_loadu_pd(t + i), _mm256_mul_pd(s4, _mm256_loadu_pd(v + i))));
+        }
+    #endif
+    #if defined(__SSE2__)
+        const __m128d s2 = _mm_set1_pd(s);
+        for(; i + 2 <= dim; i += 2) {
+          _mm_storeu_pd(t + i, _mm_add_pd(_mm_loadu_pd(t + i), _mm_mul_pd(s2, _mm_loadu_pd(v + i))));
+        }
+    #endif
+        for(; i < dim; ++i) {
+          t[i] += s * v[i];
+        }
+  #endif
+      }
+  };
+#endif
+
   /**
    * @brief The vector for direction of the forward mode or the reverse mode.
    *
@@ -141,8 +280,21 @@ namespace codi {
        * @return Reference to this object.
        */
       CODI_INLINE Direction<Real, dim>& operator += (const Direction<Real, dim>& v) {
+        DirectionKernels<Real, dim>::add(this->vector, v.vector);
+
+        return *this;
+      }
+
+      /**
+       * @brief Update operator for the direction.
+       *
+       * @param[in] v  The values from the direction are subtracted from the values of this direction object.
+       *
+       * @return Reference to this object.
+       */
+      CODI_INLINE Direction<Real, dim>& operator -= (const Direction<Real, dim>& v) {
         for(size_t i = 0; i < dim; ++i) {
-          this->vector[i] += v.vector[i];
+          this->vector[i] -= v.vector[i];
         }
 
         return *this;
@@ -226,6 +378,23 @@ namespace codi {
     return s * v;
   }
 
+  /**
+   * @brief Fused scaled addition for directions.
+   *
+   * Performs the operation t += v * s without the temporary direction of the product.
+   *
+   * @param[in,out] t  The direction that is updated.
+   * @param[in]     v  The direction that is scaled.
+   * @param[in]     s  The scalar value for the multiplication.
+   *
+   * @tparam Real  The scalar value type that is used by the direction.
+   * @tparam  dim  The dimension of the direction.
+   */
+  template<typename Real, size_t dim>
+  CODI_INLINE void addScaled(Direction<Real, dim>& t, const Direction<Real, dim>& v, const Real& s) {
+    DirectionKernels<Real, dim>::addScaled(&t[0], &v[0], s);
+  }
+
   /**
    * @brief Scalar division of a direction.
    *
@@ -102,6 +102,9 @@ namespace codi {
       /** @brief The write mode of the file. Used for error checking. */
       bool writeMode;
 
+      /** @brief If the file is closed by the handle. */
+      bool ownsFile;
+
     public:
 
       /**
@@ -115,6 +118,7 @@ namespace codi {
       CoDiIoHandle(const std::string& file, bool write) {
         writeMode = write;
         fileHandle = NULL;
+        ownsFile = true;
 
         if(write) {
           fileHandle = fopen(file.c_str(), "wb");
@@ -127,11 +131,30 @@ namespace codi {
         }
       }
 
+      /**
+       * @brief Create a handle for an already opened file.
+       *
+       * The file position is set to the given offset. The file is not closed by the handle.
+       *
+       * @param[in]   file  The handle of the opened file. The file needs to be opened in binary mode.
+       * @param[in] offset  The position in bytes from the beginning of the file.
+       * @param[in]  write  If the file is opened for reading. Otherwise for writing.
+       */
+      CoDiIoHandle(FILE* file, long offset, bool write) {
+        writeMode = write;
+        fileHandle = file;
+        ownsFile = false;
+
+        if(0 != fseek(fileHandle, offset, SEEK_SET)) {
+          throw IoException(IoError::Mode , "Could not set the position in the file.", true);
+        }
+      }
+
       /**
        * @brief Close the file.
        */
       ~CoDiIoHandle() {
-        if(NULL != fileHandle) {
+        if(NULL != fileHandle && ownsFile) {
           fclose(fileHandle);
         }
       }
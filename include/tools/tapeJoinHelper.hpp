@@ -0,0 +1,247 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#pragma once
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include "../configure.h"
+#include "../macros.h"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Joins the recordings of several tapes into one reverse evaluation.
+   *
+   * With the option CODI_ThreadLocalTape each thread records on its own global tape. The helper collects the
+   * recorded ranges of these tapes in the order of the recording and evaluates them in the reverse order with one
+   * adjoint vector.
+   *
+   * A usage example is:
+   * \code{.cpp}
+   *  codi::TapeJoinHelper<codi::RealReverseIndex> join;
+   *
+   *  tape.setActive();
+   *  // register the inputs
+   *  join.addRecording(tape, start, tape.getPosition());
+   *
+   *  #pragma omp parallel
+   *  {
+   *    codi::RealReverseIndex::TapeType& threadTape = codi::RealReverseIndex::getGlobalTape();
+   *    threadTape.setActive();
+   *    auto threadStart = threadTape.getPosition();
+   *    // record the independent parts
+   *    join.addRecording(threadTape, threadStart, threadTape.getPosition());
+   *  }
+   *
+   *  join.resizeAdjoints();
+   *  join.gradient(y.getGradientData()) = 1.0;
+   *  join.evaluate();
+   * \endcode
+   *
+   * The recordings that are added concurrently are evaluated in an arbitrary order. They must not depend on each
+   * other, that is the outputs of one recording must not be an input of the other one.
+   *
+   * The indices of the tapes must not overlap. The index handlers ReuseIndexHandler, ReuseIndexHandlerUseCount and
+   * SortedReuseIndexHandlerUseCount take their indices from a process wide range if CODI_ThreadLocalTape is set. Tapes with the linear index handler
+   * can not be joined since the indices are the statement numbers of each tape, they are rejected together with
+   * CODI_ThreadLocalTape. Primal value tapes can not be joined
+   * since each tape evaluates with its own primal values. All tapes that created indices used in the recordings need
+   * to be part of the join, otherwise the adjoint vector can be too small.
+   *
+   * @tparam      CoDiType  This is the CoDiPack type that is used in the application, e.g. RealReverseIndex.
+   * @tparam GradientValue  The type of the entries in the adjoint vector.
+   */
+  template<typename CoDiType, typename GradientValue = typename CoDiType::GradientValue>
+  struct TapeJoinHelper {
+
+      typedef typename CoDiType::TapeType Tape; /**< The type of the tape implementation. */
+      typedef typename Tape::Position Position; /**< The position for the tape. */
+      typedef typename Tape::Index Index; /**< The identifier type for the adjoint values. */
+
+      static_assert(!Tape::IndexHandler::IsLinear, "The indices of tapes with a linear index handler overlap.");
+      static_assert(Tape::AllowJacobiOptimization, "Primal value tapes store the primal values for each tape.");
+
+    private:
+
+      /**
+       * @brief The data for one recorded range.
+       */
+      struct Recording {
+          Tape* tape; /**< The tape of the recording. */
+          Position start; /**< The position before the recording. */
+          Position end; /**< The position after the recording. */
+          size_t adjointSize; /**< The adjoint size of the tape after the recording. */
+
+          /**
+           * @brief Create the data for one range.
+           *
+           * @param[in]        tape  The tape of the recording.
+           * @param[in]       start  The position before the recording.
+           * @param[in]         end  The position after the recording.
+           * @param[in] adjointSize  The adjoint size of the tape after the recording.
+           */
+          Recording(Tape* tape, const Position& start, const Position& end, const size_t adjointSize) :
+            tape(tape),
+            start(start),
+            end(end),
+            adjointSize(adjointSize) {}
+      };
+
+      std::vector<Recording> recordings; /**< The ranges in the order of the recording. */
+
+      std::vector<GradientValue> adjoints; /**< The adjoint vector for the joined evaluation. */
+
+      std::mutex mutex; /**< Guards the concurrent addition of recordings. */
+
+    public:
+
+      /**
+       * @brief Create an empty join.
+       */
+      TapeJoinHelper() :
+        recordings(),
+        adjoints(),
+        mutex() {}
+
+      /**
+       * @brief Add the range of a tape after the previously added ranges.
+       *
+       * The method can be called concurrently from several threads. It has to be called by the thread that recorded
+       * on the tape, since the index handler of a thread local tape can only be queried from its own thread.
+       *
+       * @param[in]  tape  The tape of the recording.
+       * @param[in] start  The position before the recording.
+       * @param[in]   end  The position after the recording.
+       */
+      void addRecording(Tape& tape, const Position& start, const Position& end) {
+        size_t adjointSize = (size_t)tape.getAdjointSize();
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        recordings.push_back(Recording(&tape, start, end, adjointSize));
+      }
+
+      /**
+       * @brief Remove all recordings.
+       *
+       * The tapes themselves are not reset.
+       */
+      void clear() {
+        recordings.clear();
+      }
+
+      /**
+       * @brief Get the number of the added recordings.
+       *
+       * @return The number of the recordings.
+       */
+      size_t getRecordingCount() const {
+        return recordings.size();
+      }
+
+      /**
+       * @brief The largest adjoint size of all tapes of the recordings.
+       *
+       * The sizes are taken when the recordings are added.
+       *
+       * @return The maximum index of all tapes.
+       */
+      size_t getAdjointSize() const {
+        size_t size = 0;
+        for(size_t i = 0; i < recordings.size(); ++i) {
+          size = std::max(size, recordings[i].adjointSize);
+        }
+
+        return size;
+      }
+
+      /**
+       * @brief Resize the internal adjoint vector such that it can hold all indices of the tapes.
+       */
+      void resizeAdjoints() {
+        size_t size = getAdjointSize() + 1;
+        if(adjoints.size() < size) {
+          adjoints.resize(size);
+        }
+      }
+
+      /**
+       * @brief Set all entries of the internal adjoint vector to zero.
+       */
+      void clearAdjoints() {
+        for(size_t i = 0; i < adjoints.size(); ++i) {
+          adjoints[i] = GradientValue();
+        }
+      }
+
+      /**
+       * @brief Access the entry of the internal adjoint vector.
+       *
+       * resizeAdjoints() needs to be called after the recording.
+       *
+       * @param[in] index  The index of the value.
+       *
+       * @return The reference to the adjoint value.
+       */
+      GradientValue& gradient(const Index& index) {
+        codiAssert((size_t)index < adjoints.size());
+
+        return adjoints[index];
+      }
+
+      /**
+       * @brief Evaluate all recordings in the reverse order with the internal adjoint vector.
+       */
+      void evaluate() {
+        resizeAdjoints();
+
+        evaluate(adjoints.data());
+      }
+
+      /**
+       * @brief Evaluate all recordings in the reverse order.
+       *
+       * @param[in,out] adjointData  The vector for the adjoint evaluation. It has to have the size of
+       *                             getAdjointSize() + 1.
+       *
+       * @tparam AdjointData  The data for the adjoint vector it needs to support add, multiply and comparison operations.
+       */
+      template<typename AdjointData>
+      void evaluate(AdjointData* adjointData) {
+        for(size_t i = recordings.size(); i > 0; --i) {
+          Recording& cur = recordings[i - 1];
+          cur.tape->evaluate(cur.end, cur.start, adjointData);
+        }
+      }
+  };
+}
@@ -35,6 +35,7 @@
 #include "../adjointInterfaceImpl.hpp"
 #include "../configure.h"
 #include "../exceptions.hpp"
+#include "../tapes/dirtyAdjointRange.hpp"
 
 /**
  * @brief Global namespace for CoDiPack - Code Differentiation Package
@@ -245,6 +246,8 @@ namespace codi {
 
       AdjointInterfaceImpl<Real, GradientValue>* adjointInterface; /**< General access to the adjoint vector for the generalized interface. */
 
+      DirtyAdjointRange<GradientData, Position> dirtyAdjoints; /**< The part of the adjoint vector that is reset by clearAdjoints. */
+
       /**
        * @brief Create a new instance which uses the global tape as the default tape in the background.
        */
@@ -253,7 +256,8 @@ namespace codi {
         adjointVector(0),
         zeroValue(),
         constZeroValue(),
-        adjointInterface(nullptr) {
+        adjointInterface(nullptr),
+        dirtyAdjoints() {
       }
 
       /**
@@ -271,6 +275,7 @@ namespace codi {
       void deleteAdjointVector() {
         adjointVector.resize(0);
         adjointVector.shrink_to_fit();
+        dirtyAdjoints.reset();
       }
 
       /**
@@ -304,6 +309,8 @@ namespace codi {
        * @return The gradient value from the internal adjoint vector.
        */
       GradientValue& gradientAt(const GradientData& value) {
+        dirtyAdjoints.addIndex(value);
+
         return adjointVector[value];
       }
 
@@ -331,6 +338,8 @@ namespace codi {
         checkAdjointVectorSize();
 
         if(0 != value && value < (GradientData)adjointVector.size()) {
+          dirtyAdjoints.addIndex(value);
+
           return adjointVector[value];
         } else {
           zeroValue = GradientValue();
@@ -364,6 +373,10 @@ namespace codi {
       void evaluate(const Position& start, const Position& end) {
         checkAdjointVectorSize();
 
+        // the ranges are inspected directly since the helper is not notified about changes of the tape
+        dirtyAdjoints.addRange(this->tape, start, end);
+        dirtyAdjoints.mergeRanges(this->tape);
+
         this->tape.evaluate(start, end, adjointVector.data());
       }
 
@@ -371,11 +384,12 @@ namespace codi {
 
       /**
        * @brief Reset all adjoint to there default value.
+       *
+       * Only the adjoint values which have been accessed by the methods of the helper or by an evaluation since the
+       * last clear are reset, see DirtyAdjointRange.
        */
       void clearAdjoints() {
-        for(size_t i = 0; i < adjointVector.size(); i += 1) {
-          adjointVector[i] = GradientValue();
-        }
+        dirtyAdjoints.clear(this->tape, adjointVector.data(), adjointVector.size());
       }
 
       /**
@@ -391,6 +405,8 @@ namespace codi {
         }
 
         checkAdjointVectorSize();
+        // the interface can modify arbitrary entries
+        dirtyAdjoints.addAll();
         adjointInterface = new AdjointInterfaceImpl<Real, GradientValue> (adjointVector.data());
         return adjointInterface;
       }
@@ -74,6 +74,55 @@ namespace codi {
   CODI_INLINE bool isTotalZero(const T& t) {
     return IsTotalZeroImpl<T>::isTotalZero(t);}
 
+  /**
+   * @brief Add the value scaled by the Jacobian to the target.
+   *
+   * Performs the operation target += value * jacobi. Types with a fused implementation, e.g. codi::Direction,
+   * provide an overload that avoids the temporary of the product.
+   *
+   * @param[in,out] target  The value that is updated.
+   * @param[in]      value  The value that is scaled.
+   * @param[in]     jacobi  The scaling factor.
+   *
+   * @tparam Target  The type of the updated value.
+   * @tparam  Value  The type of the scaled value.
+   * @tparam Jacobi  The type of the scaling factor.
+   */
+  template <typename Target, typename Value, typename Jacobi>
+  CODI_INLINE void addScaled(Target& target, const Value& value, const Jacobi& jacobi) {
+    target += value * jacobi;
+  }
+
+  /**
+   * @brief Prefetch the adjoint values for the upcoming arguments of a reverse evaluation.
+   *
+   * The adjoint values for the entries in the range [max(end, pos - PrefetchArgumentDistance), prefetchPos) of the
+   * index data are prefetched and prefetchPos is moved to the lower bound of the range. Each entry is prefetched only once
+   * if prefetchPos is initialized with the starting position of the evaluation.
+   *
+   * @param[in]        adjoints  The adjoint vector.
+   * @param[in]         indices  The index data of the arguments.
+   * @param[in,out] prefetchPos  The lowest position which has already been prefetched.
+   * @param[in]             pos  The current position of the evaluation.
+   * @param[in]             end  The ending position of the evaluation.
+   * @param[in]           shift  The number of tag bits in the stored indices.
+   *
+   * @tparam  AdjointData  The type of the adjoint values.
+   * @tparam IndexPointer  The pointer type for the index data.
+   */
+  template <typename AdjointData, typename IndexPointer>
+  CODI_INLINE void prefetchAdjointsReverse(const AdjointData* adjoints, const IndexPointer& indices,
+                                           size_t& prefetchPos, const size_t& pos, const size_t& end,
+                                           const int shift = 0) {
+    if(0 != PrefetchArgumentDistance) {
+      const size_t target = pos > end + PrefetchArgumentDistance ? pos - PrefetchArgumentDistance : end;
+      while(prefetchPos > target) {
+        --prefetchPos;
+        CODI_PREFETCH(&adjoints[indices[prefetchPos] >> shift]);
+      }
+    }
+  }
+
 #ifndef DOXYGEN_DISABLE
   // Take address of a T instance
   template <typename T, typename Enable = void>
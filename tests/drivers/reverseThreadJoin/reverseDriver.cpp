@@ -0,0 +1,187 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#include <toolDefines.h>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+/*
+ * Each thread records the function on its thread local tape. The recordings are joined with the TapeJoinHelper
+ * and the Jacobian of the joined evaluation, divided by the number of threads, is compared with the Jacobian of
+ * a sequential recording. The output is the sequential Jacobian and a line for each mismatch.
+ */
+
+bool isEqual(double a, double b) {
+  if(a == b || (std::isnan(a) && std::isnan(b))) {
+    return true;
+  }
+
+  return std::abs(a - b) <= 1e-10 * std::max(1.0, std::max(std::abs(a), std::abs(b)));
+}
+
+int main(int nargs, char** args) {
+  (void)nargs;
+  (void)args;
+
+#ifdef _OPENMP
+  int threads = omp_get_max_threads();
+#else
+  int threads = 1;
+#endif
+
+  int evalPoints = getEvalPointsCount();
+  int inputs = getInputCount();
+  int outputs = getOutputCount();
+  NUMBER* x = new NUMBER[inputs];
+  NUMBER* y = new NUMBER[outputs];
+
+  NUMBER::TapeType& tape = NUMBER::getGlobalTape();
+
+  for(int curPoint = 0; curPoint < evalPoints; ++curPoint) {
+    std::cout << "Point " << curPoint << " : {";
+
+    for(int i = 0; i < inputs; ++i) {
+      if(i != 0) {
+        std::cout << ", ";
+      }
+      double val = getEvalPoint(curPoint, i);
+      std::cout << val;
+
+      x[i] = (NUMBER)(val);
+    }
+    std::cout << "}\n";
+
+    for(int i = 0; i < outputs; ++i) {
+      y[i] = 0.0;
+    }
+
+    // sequential reference
+    std::vector<std::vector<double> > jac(outputs);
+    for(int curOut = 0; curOut < outputs; ++curOut) {
+      tape.setActive();
+      for(int i = 0; i < inputs; ++i) {
+        tape.registerInput(x[i]);
+      }
+
+      func(x, y);
+
+      for(int i = 0; i < outputs; ++i) {
+        tape.registerOutput(y[i]);
+      }
+
+      tape.setPassive();
+
+      for(int i = 0; i < outputs; ++i) {
+        y[i].setGradient(i == curOut ? 1.0:0.0);
+      }
+
+      tape.evaluate();
+
+      for(int curIn = 0; curIn < inputs; ++curIn) {
+        jac[curOut].push_back(x[curIn].getGradient());
+      }
+
+      tape.reset();
+      tape.clearAdjoints();
+    }
+
+    // the same recording on all threads
+    codi::TapeJoinHelper<NUMBER> join;
+
+    tape.setActive();
+    NUMBER::TapeType::Position start = tape.getPosition();
+    for(int i = 0; i < inputs; ++i) {
+      tape.registerInput(x[i]);
+    }
+    tape.setPassive();
+    join.addRecording(tape, start, tape.getPosition());
+
+    std::vector<std::vector<NUMBER> > yThreads(threads, std::vector<NUMBER>(outputs));
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(threads)
+#endif
+    {
+#ifdef _OPENMP
+      int curThread = omp_get_thread_num();
+#else
+      int curThread = 0;
+#endif
+      NUMBER::TapeType& threadTape = NUMBER::getGlobalTape();
+      if(&threadTape != &tape) {
+        threadTape.reset(); // the tape of the main thread still holds the inputs
+      }
+      threadTape.setActive();
+      NUMBER::TapeType::Position threadStart = threadTape.getPosition();
+
+      std::vector<NUMBER> xThread(x, x + inputs);
+      std::vector<NUMBER>& yThread = yThreads[curThread];
+      func(xThread.data(), yThread.data());
+
+      for(int i = 0; i < outputs; ++i) {
+        threadTape.registerOutput(yThread[i]);
+      }
+
+      threadTape.setPassive();
+      join.addRecording(threadTape, threadStart, threadTape.getPosition());
+    }
+
+    for(int curOut = 0; curOut < outputs; ++curOut) {
+      join.resizeAdjoints();
+      join.clearAdjoints();
+      for(int curThread = 0; curThread < threads; ++curThread) {
+        NUMBER::GradientData index = yThreads[curThread][curOut].getGradientData();
+        if(0 != index) {
+          join.gradient(index) = 1.0;
+        }
+      }
+
+      join.evaluate();
+
+      for(int curIn = 0; curIn < inputs; ++curIn) {
+        double value = join.gradient(x[curIn].getGradientData()) / threads;
+        if(!isEqual(value, jac[curOut][curIn])) {
+          std::cout << "Join mismatch " << curIn << " " << curOut << " " << value << std::endl;
+        }
+      }
+    }
+
+    tape.reset();
+
+    for(int curIn = 0; curIn < inputs; ++curIn) {
+      for(int curOut = 0; curOut < outputs; ++curOut) {
+        std::cout << curIn << " " << curOut << " " << jac[curOut][curIn] << std::endl;
+      }
+    }
+  }
+}
@@ -0,0 +1,54 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#include <toolDefines.h>
+
+#include <utility>
+#include <vector>
+
+IN(2)
+OUT(2)
+POINTS(1) = {{2.0, 3.0}};
+
+void func(NUMBER* x, NUMBER* y) {
+  NUMBER a = x[0] * x[1];
+  NUMBER b(std::move(a));
+  NUMBER c = x[0] + x[1];
+  std::swap(b, c);
+
+  std::vector<NUMBER> v;
+  for(int i = 0; i < 10; ++i) {
+    v.push_back(x[i % 2] * (double)(i + 1));
+  }
+
+  NUMBER d;
+  d = std::move(v[3]);
+  c = std::move(v[4]);
+
+  y[0] = b * d;
+  y[1] = std::move(c);
+}
@@ -0,0 +1,94 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#include <toolDefines.h>
+
+#include <iostream>
+#include <vector>
+
+#include <stdint.h>
+
+IN(1)
+OUT(1)
+POINTS(1) = {{1.0}};
+
+/*
+ * Creates ten indices and frees the third and the fifth one.
+ */
+template<typename IndexHandler>
+size_t countGapsSimple() {
+  IndexHandler handler(0);
+  int indices[10];
+
+  for(int i = 0; i < 10; ++i) {
+    indices[i] = handler.createIndex();
+  }
+  handler.freeIndex(indices[2]);
+  handler.freeIndex(indices[4]);
+
+  return handler.getNumberIndexGaps();
+}
+
+/*
+ * Creates and frees the indices of 4096 variables in a fixed random pattern. The number of gaps is the value of the
+ * "Index gaps" entry in the tape statistics.
+ */
+template<typename IndexHandler>
+size_t countGaps() {
+  IndexHandler handler(0);
+  std::vector<int> indices(4096, 0);
+
+  uint32_t state = 12345;
+  for(size_t step = 0; step < 100000; ++step) {
+    state = state * 1664525u + 1013904223u;
+    int& index = indices[(state >> 8) % indices.size()];
+
+    if(0 == index) {
+      index = handler.createIndex();
+    } else {
+      handler.freeIndex(index);
+    }
+  }
+
+  return handler.getNumberIndexGaps();
+}
+
+template<typename IndexHandler>
+void checkHandler(const char* name) {
+  std::cout << name << ": " << countGapsSimple<IndexHandler>() << " gaps simple, "
+            << countGaps<IndexHandler>() << " gaps random" << std::endl;
+}
+
+void func(NUMBER* x, NUMBER* y) {
+  // The reuse handlers without sorting hand out the indices of a new block from the largest one downwards.
+  checkHandler<codi::ReuseIndexHandler<int> >("ReuseIndexHandler");
+  checkHandler<codi::ReuseIndexHandlerUseCount<int> >("ReuseIndexHandlerUseCount");
+  checkHandler<codi::SortedReuseIndexHandlerUseCount<int> >("SortedReuseIndexHandlerUseCount");
+
+  y[0] = x[0];
+}
@@ -0,0 +1,91 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#include <toolDefines.h>
+
+#include <iostream>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+IN(1)
+OUT(1)
+POINTS(1) = {{1.0}};
+
+/*
+ * The index overflow exception terminates the program, therefore the indices are created in a child process. The
+ * exit code of CODI_EXCEPTION is -1.
+ */
+template<typename IndexHandler>
+const char* createIndices(const size_t count) {
+  std::cout.flush();
+
+  pid_t pid = fork();
+  if(0 == pid) {
+    if(NULL == freopen("/dev/null", "w", stderr)) {
+      _exit(2);
+    }
+
+    IndexHandler handler(0);
+    for(size_t i = 0; i < count; ++i) {
+      handler.createIndex();
+    }
+
+    _exit(0);
+  }
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+
+  if(WIFEXITED(status) && 0 == WEXITSTATUS(status)) {
+    return "ok";
+  } else if(WIFEXITED(status) && 255 == WEXITSTATUS(status)) {
+    return "overflow";
+  } else {
+    return "failure";
+  }
+}
+
+template<typename IndexHandler>
+void checkHandler(const char* name) {
+  // uint16_t can represent 65535 indices
+  std::cout << name << ": 30000 indices " << createIndices<IndexHandler>(30000)
+            << ", 70000 indices " << createIndices<IndexHandler>(70000) << std::endl;
+}
+
+void func(NUMBER* x, NUMBER* y) {
+  checkHandler<codi::LinearIndexHandler<uint16_t> >("LinearIndexHandler");
+  checkHandler<codi::ReuseIndexHandler<uint16_t> >("ReuseIndexHandler");
+  checkHandler<codi::ReuseIndexHandlerUseCount<uint16_t> >("ReuseIndexHandlerUseCount");
+  checkHandler<codi::SortedReuseIndexHandlerUseCount<uint16_t> >("SortedReuseIndexHandlerUseCount");
+
+  y[0] = x[0];
+}